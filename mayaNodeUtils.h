@@ -53,6 +53,7 @@ All as one loop to a struct. Probably a little faster, but harder to read.
 #include <maya/MFnFloatVectorArrayData.h>
 #include <maya/MFnGeometryData.h>
 #include <maya/MFnIntArrayData.h>
+#include <maya/MFnLattice.h>
 #include <maya/MFnLatticeData.h>
 #include <maya/MFnMatrixArrayData.h>
 #include <maya/MFnMatrixData.h>
@@ -61,10 +62,12 @@ All as one loop to a struct. Probably a little faster, but harder to read.
 #include <maya/MFnNIdData.h>
 #include <maya/MFnNObjectData.h>
 #include <maya/MFnNumericData.h>
+#include <maya/MFnNurbsCurve.h>
 #include <maya/MFnNurbsCurveData.h>
 #include <maya/MFnNurbsSurfaceData.h>
 #include <maya/MFnPluginData.h>
 #include <maya/MFnPointArrayData.h>
+#include <maya/MFnSingleIndexedComponent.h>
 #include <maya/MFnSphereData.h>
 #include <maya/MFnStringArrayData.h>
 #include <maya/MFnStringData.h>
@@ -82,23 +85,198 @@ All as one loop to a struct. Probably a little faster, but harder to read.
 #include <maya/MObjectArray.h>
 #include <maya/MPlugArray.h>
 #include <maya/MPointArray.h>
+#include <maya/MPxData.h>
 #include <maya/MPxGeometryFilter.h>
 #include <maya/MStringArray.h>
 #include <maya/MTime.h>
 #include <maya/MTimeArray.h>
+#include <maya/MTypeId.h>
 #include <maya/MTypes.h>  // defines types like float3/double4/int2/etc...
 #include <maya/MUint64Array.h>
 #include <maya/MUintArray.h>
 #include <maya/MVectorArray.h>
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <functional>
 #include <iterator>
+#include <list>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <string_view>
 #include <type_traits>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
+#if defined(__AVX__) || defined(__SSE__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
 namespace maya_node_utils {
 
+/************************************
+Error policies
+*************************************
+Every getter and setter takes its status argument as a pointer to an error policy.
+
+    MStatus (the default): Works like it always has. The status gets overwritten by each maya
+        call, and the function bails out on the first failure
+    IgnoreErrors: Don't even ask maya for a status. In release builds this compiles down to
+        straight-line code in the per-element loops
+    FirstError: Keep the first failure and its message, and bail out
+    CollectErrors: Keep every failure and its message
+    ThrowErrors: Throw an MStatusException on the first failure
+
+A failure from a valueGetter never stops the per-element loop. That element just gets whatever
+the valueGetter returned.
+
+When MAYA_NODE_UTILS_DEBUG_ERRORS is on (the default when NDEBUG isn't defined) every failure
+gets perror'd, even with IgnoreErrors.
+
+    FirstError errors;
+    getFullArrayHandleData(dataBlock, aMatrix, mats, &errors);
+    if (!errors.status) { return errors.status; }
+************************************/
+
+#ifndef MAYA_NODE_UTILS_DEBUG_ERRORS
+#ifdef NDEBUG
+#define MAYA_NODE_UTILS_DEBUG_ERRORS 0
+#else
+#define MAYA_NODE_UTILS_DEBUG_ERRORS 1
+#endif
+#endif
+
+struct IgnoreErrors {
+    static constexpr bool enabled = MAYA_NODE_UTILS_DEBUG_ERRORS;
+    inline bool report(const MStatus& result, const char* msg) { return true; }
+};
+
+struct FirstError {
+    static constexpr bool enabled = true;
+    MStatus status;
+    const char* message = nullptr;
+    inline bool report(const MStatus& result, const char* msg) {
+        if (result) {
+            return true;
+        }
+        if (status) {
+            status = result;
+            message = msg;
+        }
+        return false;
+    }
+};
+
+struct ErrorRecord {
+    MStatus status;
+    const char* message;
+};
+
+struct CollectErrors {
+    static constexpr bool enabled = true;
+    std::vector<ErrorRecord> errors;
+    inline bool report(const MStatus& result, const char* msg) {
+        if (result) {
+            return true;
+        }
+        errors.push_back({result, msg});
+        return false;
+    }
+};
+
+class MStatusException : public std::runtime_error {
+   public:
+    MStatusException(const MStatus& inStatus, const char* msg)
+        : std::runtime_error(msg), status(inStatus) {}
+    MStatus status;
+};
+
+struct ThrowErrors {
+    static constexpr bool enabled = true;
+    inline bool report(const MStatus& result, const char* msg) {
+        if (!result) {
+            throw MStatusException(result, msg);
+        }
+        return true;
+    }
+};
+
+// clang-format off
+// Get the policy from the status argument type. A bare nullptr means MStatus
+// This also keeps non-pointer arguments from matching a status parameter
+template <typename Status> struct ErrorPolicyOf;
+template <typename P>      struct ErrorPolicyOf<P*>             { using type = P;       };
+template <>                struct ErrorPolicyOf<std::nullptr_t> { using type = MStatus; };
+template <typename Status> using ErrorPolicyT = typename ErrorPolicyOf<Status>::type;
+
+template <typename ErrorPolicy> struct ErrorsEnabled          { static constexpr bool value = ErrorPolicy::enabled; };
+template <>                     struct ErrorsEnabled<MStatus> { static constexpr bool value = true;                 };
+template <typename Status> inline constexpr bool ErrorsEnabledV = ErrorsEnabled<ErrorPolicyT<Status>>::value;
+// clang-format on
+
+// The MStatus* to hand to maya. This is nullptr when the policy doesn't care, so maya can skip it
+template <typename Status>
+inline MStatus* statusArg(MStatus& localStatus) {
+    if constexpr (ErrorsEnabledV<Status>) {
+        return &localStatus;
+    } else {
+        return nullptr;
+    }
+}
+
+// Hand a maya status to the policy. Returns false if the caller should bail out
+template <typename Status>
+inline bool reportStatus(Status status, const MStatus& result, const char* msg) {
+    using ErrorPolicy = ErrorPolicyT<Status>;
+    if constexpr (!ErrorsEnabledV<Status>) {
+        return true;
+    } else {
+#if MAYA_NODE_UTILS_DEBUG_ERRORS
+        if (!result) {
+            result.perror(msg);
+        }
+#endif
+        if constexpr (std::is_same_v<Status, std::nullptr_t>) {
+            return result == MStatus::kSuccess;
+        } else if constexpr (std::is_same_v<ErrorPolicy, MStatus>) {
+            if (status) {
+                *status = result;
+            }
+            return result == MStatus::kSuccess;
+        } else {
+            if (status) {
+                return status->report(result, msg);
+            }
+            return ErrorPolicy().report(result, msg);
+        }
+    }
+}
+
+// Get a single element value, and hand any failure to the policy
+template <typename ValueGetter, typename Status>
+inline auto getElementValue(ValueGetter&& valueGetter, MDataHandle& handle, Status status) {
+    if constexpr (std::is_same_v<ErrorPolicyT<Status>, MStatus>) {
+        return valueGetter(handle, status);
+    } else if constexpr (!ErrorsEnabledV<Status>) {
+        return valueGetter(handle, nullptr);
+    } else {
+        MStatus elementStatus;
+        auto ret = valueGetter(handle, &elementStatus);
+        reportStatus(status, elementStatus, "Could not get the value of an array element");
+        return ret;
+    }
+}
+
 /************************************
 A consistent way for pulling the stored type from std::vector and Maya arrays
 ************************************/
@@ -140,20 +318,179 @@ template <typename Container> using FnSetTypeT = typename FnSetType<Container>::
 
 template <typename T, typename MFnT>
 inline T hg_impl(MDataHandle &handle, MStatus* status=nullptr) {
-    MStatus localStatus;
-    MStatus* st = status ? status : &localStatus;
-
     MObject ret = handle.data();
     if (ret.isNull()){
-        *st = MStatus::kFailure;
-        st->perror("Handle had a null object");
+        if (status) {
+            *status = MStatus::kFailure;
+        }
+        return T();
+    }
+    MFnT mfnd(ret, status);
+    if (status && !*status) {
         return T();
     }
-    MFnT mfnd(ret, st);
-    if (st) {
-        return mfnd.array();
+    return mfnd.array();
+}
+
+/*
+Geometry views
+These hold on to the geometry data object and read straight from it, instead of copying
+everything into new arrays. They're only valid as long as the data they came from is, so
+for inputs that means the current compute
+*/
+struct MeshView {
+    MObject object;
+    const float* points = nullptr;  // xyz xyz xyz ... straight out of the mesh data
+    int numVertices = 0;
+    int numPolygons = 0;
+    int numFaceVertices = 0;
+
+    bool isValid() const { return points != nullptr; }
+
+    // The API doesn't expose the raw topology, so this one copies. Only ask for it when needed
+    MStatus getTopology(MIntArray& counts, MIntArray& connects) const {
+        MStatus status;
+        MFnMesh fnMesh(object, &status);
+        if (!status) {
+            return status;
+        }
+        return fnMesh.getVertices(counts, connects);
+    }
+};
+
+// The API doesn't give raw access to nurbs curve CVs, so this keeps the counts and reads the CVs
+// on demand
+struct NurbsCurveView {
+    MObject object;
+    int numCVs = 0;
+    int numSpans = 0;
+    int degree = 0;
+    MFnNurbsCurve::Form form = MFnNurbsCurve::kInvalid;
+
+    bool isValid() const { return numCVs > 0; }
+
+    MStatus getCVs(MPointArray& cvs) const {
+        MStatus status;
+        MFnNurbsCurve fnCurve(object, &status);
+        if (!status) {
+            return status;
+        }
+        return fnCurve.getCVs(cvs);
+    }
+};
+
+// MFnLattice::point hands back a reference into the lattice, so this reads points in place
+// The function set only gets made the first time a point is read, and then it's shared
+// between copies of the view
+struct LatticeView {
+    MObject object;  // The lattice geometry, not the lattice data
+    mutable std::shared_ptr<MFnLattice> fnLattice;
+    unsigned int sDivisions = 0;
+    unsigned int tDivisions = 0;
+    unsigned int uDivisions = 0;
+
+    bool isValid() const { return !object.isNull() && sDivisions * tDivisions * uDivisions > 0; }
+    unsigned int numPoints() const { return sDivisions * tDivisions * uDivisions; }
+
+    // This is input data, so it's read only. An invalid view gives back the origin
+    const MPoint& point(unsigned int s, unsigned int t, unsigned int u, MStatus* status=nullptr) const {
+        if (!fnLattice) {
+            if (!isValid()) {
+                if (status) {
+                    *status = MStatus::kInvalidParameter;
+                }
+                return MPoint::origin;
+            }
+            fnLattice = std::make_shared<MFnLattice>();
+            fnLattice->setObject(object);
+        }
+        return fnLattice->point(s, t, u, status);
+    }
+};
+
+inline MeshView getMeshView(MDataHandle& handle, MStatus* status=nullptr) {
+    MeshView ret;
+    ret.object = handle.data();
+    MFnMesh fnMesh(ret.object, status);
+    if (status && !*status) {
+        return MeshView();
+    }
+    ret.points = fnMesh.getRawPoints(status);
+    ret.numVertices = fnMesh.numVertices();
+    ret.numPolygons = fnMesh.numPolygons();
+    ret.numFaceVertices = fnMesh.numFaceVertices();
+    return ret;
+}
+
+inline NurbsCurveView getNurbsCurveView(MDataHandle& handle, MStatus* status=nullptr) {
+    NurbsCurveView ret;
+    ret.object = handle.data();
+    MFnNurbsCurve fnCurve(ret.object, status);
+    if (status && !*status) {
+        return NurbsCurveView();
+    }
+    ret.numCVs = fnCurve.numCVs();
+    ret.numSpans = fnCurve.numSpans();
+    ret.degree = fnCurve.degree();
+    ret.form = fnCurve.form();
+    return ret;
+}
+
+inline LatticeView getLatticeView(MDataHandle& handle, MStatus* status=nullptr) {
+    LatticeView ret;
+    MFnLatticeData fnData(handle.data(), status);
+    if (status && !*status) {
+        return LatticeView();
+    }
+    ret.object = fnData.lattice(status);
+    if (status && !*status) {
+        return LatticeView();
+    }
+    MFnLattice fnLattice(ret.object, status);
+    if (status && !*status) {
+        return LatticeView();
+    }
+    fnLattice.getDivisions(ret.sDivisions, ret.tDivisions, ret.uDivisions);
+    return ret;
+}
+
+/*
+Plugin data
+Read a custom MPxData subclass as a `const MyData*` that points straight at the data in the
+data block, so big caches can get passed between nodes without copying them.
+The type gets checked with the MTypeId from PluginDataTraits. By default that's the usual
+`static const MTypeId id;` member, so only specialize it if your class keeps its id somewhere else
+*/
+template <typename D>
+struct PluginDataTraits {
+    static MTypeId typeId() { return D::id; }
+};
+
+template <typename T>
+struct IsPluginDataPtr : std::false_type {};
+template <typename D>
+struct IsPluginDataPtr<const D*> : std::is_base_of<MPxData, D> {};
+template <typename T>
+inline constexpr bool IsPluginDataPtrV = IsPluginDataPtr<T>::value;
+
+// An owned plugin data object that a setter can hand over to the data block
+template <typename T>
+struct IsOwnedPluginData : std::false_type {};
+template <typename D>
+struct IsOwnedPluginData<std::unique_ptr<D>> : std::is_base_of<MPxData, D> {};
+template <typename T>
+inline constexpr bool IsOwnedPluginDataV = IsOwnedPluginData<T>::value;
+
+template <typename D>
+inline const D* getPluginData(MDataHandle& handle, MStatus* status=nullptr) {
+    MPxData* data = handle.asPluginData();
+    if (data == nullptr || data->typeId() != PluginDataTraits<D>::typeId()) {
+        if (status) {
+            *status = MStatus::kFailure;
+        }
+        return nullptr;
     }
-    return T();
+    return static_cast<const D*>(data);
 }
 
 template <typename T>
@@ -185,6 +522,10 @@ struct DefaultHandleValueGetter {
         else if constexpr (std::is_same_v<T, MInt64>)        { return handle.asInt64();       }
         else if constexpr (std::is_same_v<T, MMatrix>)       { return handle.asMatrix();      }
         else if constexpr (std::is_same_v<T, MObject>)       { return handle.data();          }
+        else if constexpr (std::is_same_v<T, MeshView>)      { return getMeshView(handle, status);       }
+        else if constexpr (std::is_same_v<T, NurbsCurveView>){ return getNurbsCurveView(handle, status); }
+        else if constexpr (std::is_same_v<T, LatticeView>)   { return getLatticeView(handle, status);    }
+        else if constexpr (IsPluginDataPtrV<T>)              { return getPluginData<std::remove_cv_t<std::remove_pointer_t<T>>>(handle, status); }
 
         else if constexpr (std::is_same_v<T, MDoubleArray>)      { return hg_impl<T, MFnDoubleArrayData>     (handle, status); }
         else if constexpr (std::is_same_v<T, MFloatArray>)       { return hg_impl<T, MFnFloatArrayData>      (handle, status); }
@@ -314,6 +655,17 @@ class MArrayInputDataHandleRange {
     MArrayDataHandle& m_handle;
 };
 
+// The number of slots a full array would need. Array handles walk in logical index order
+// so this is the index of the last element plus one
+inline unsigned int getArrayLogicalSize(MArrayDataHandle& arrayHandle) {
+    unsigned int count = arrayHandle.elementCount();
+    if (count == 0) {
+        return 0;
+    }
+    arrayHandle.jumpToArrayElement(count - 1);
+    return arrayHandle.elementIndex() + 1;
+}
+
 /************************************
 Templates for putting typed data into MDataHandles
 ************************************/
@@ -321,6 +673,7 @@ Templates for putting typed data into MDataHandles
 struct HandleBuilder {
     MDataHandle handle;
     MArrayDataBuilder builder;
+    bool ok = true;  // False if building failed. The failure has already gone to the policy
 };
 
 inline MDataHandle getHandleChildren(MDataHandle& handle, const std::vector<MObject>& children) {
@@ -330,234 +683,237 @@ inline MDataHandle getHandleChildren(MDataHandle& handle, const std::vector<MObj
     return handle;
 }
 
+template <typename Status = MStatus*, typename = ErrorPolicyT<Status>>
 inline MDataHandle getInputArrayHandleChildren(
     MArrayDataHandle& arrayHandle, unsigned int index, const std::vector<MObject>& children,
-    MStatus* status=nullptr
+    Status status=nullptr
 ) {
-    MStatus localStatus;
-    MStatus* st = status ? status : &localStatus;
-    *st = arrayHandle.jumpToElement(index);
-    if (!*st) {
+    MStatus st = arrayHandle.jumpToElement(index);
+    if (!reportStatus(status, st, "Could not jump to the array element")) {
         return MDataHandle();
     }
-    MDataHandle parhandle = arrayHandle.inputValue(st);
-    if (!*st) {
+    MDataHandle parhandle = arrayHandle.inputValue(statusArg<Status>(st));
+    if (!reportStatus(status, st, "Could not get the array element input value")) {
         return MDataHandle();
     }
     MDataHandle childhandle = getHandleChildren(parhandle, children);
     return childhandle;
 }
 
+template <typename Status = MStatus*, typename = ErrorPolicyT<Status>>
 inline MDataHandle getInputArrayHandleChildren(
     MDataBlock& block, MObject& arrayAttr, unsigned int index, const std::vector<MObject>& children,
-    MStatus* status=nullptr
+    Status status=nullptr
 ) {
-    MStatus localStatus;
-    MStatus* st = status ? status : &localStatus;
-    MArrayDataHandle arrayHandle = block.inputArrayValue(arrayAttr, st);
-    if (!*st) {
+    MStatus st;
+    MArrayDataHandle arrayHandle = block.inputArrayValue(arrayAttr, statusArg<Status>(st));
+    if (!reportStatus(status, st, "Could not get the input array handle")) {
         return MDataHandle();
     }
-    return getInputArrayHandleChildren(arrayHandle, index, children, st);
+    return getInputArrayHandleChildren(arrayHandle, index, children, status);
 }
 
+template <typename Status = MStatus*, typename = ErrorPolicyT<Status>>
 inline MDataHandle getOutputArrayHandleChildren(
     MArrayDataHandle& arrayHandle, unsigned int index, const std::vector<MObject>& children,
-    MStatus* status=nullptr
+    Status status=nullptr
 ) {
-    MStatus localStatus;
-    MStatus* st = status ? status : &localStatus;
-    *st = arrayHandle.jumpToElement(index);
-    if (!*st) {
+    MStatus st = arrayHandle.jumpToElement(index);
+    if (!reportStatus(status, st, "Could not jump to the array element")) {
         return MDataHandle();
     }
-    MDataHandle parhandle = arrayHandle.outputValue(st);
-    if (!*st) {
+    MDataHandle parhandle = arrayHandle.outputValue(statusArg<Status>(st));
+    if (!reportStatus(status, st, "Could not get the array element output value")) {
         return MDataHandle();
     }
     MDataHandle childhandle = getHandleChildren(parhandle, children);
     return childhandle;
 }
 
+template <typename Status = MStatus*, typename = ErrorPolicyT<Status>>
 inline MDataHandle getOutputArrayHandleChildren(
     MDataBlock& block, MObject& arrayAttr, unsigned int index, const std::vector<MObject>& children,
-    MStatus* status=nullptr
+    Status status=nullptr
 ) {
-    MStatus localStatus;
-    MStatus* st = status ? status : &localStatus;
-    MArrayDataHandle arrayHandle = block.outputArrayValue(arrayAttr, st);
-    if (!*st) {
+    MStatus st;
+    MArrayDataHandle arrayHandle = block.outputArrayValue(arrayAttr, statusArg<Status>(st));
+    if (!reportStatus(status, st, "Could not get the output array handle")) {
         return MDataHandle();
     }
-    return getOutputArrayHandleChildren(arrayHandle, index, children, st);
+    return getOutputArrayHandleChildren(arrayHandle, index, children, status);
 }
 
+template <typename Status = MStatus*, typename = ErrorPolicyT<Status>>
 inline HandleBuilder buildArrayHandleChildren(
     MArrayDataHandle& arrayHandle, unsigned int index, const std::vector<MObject>& children,
-    MStatus* status=nullptr
+    Status status=nullptr
 ) {
-    MStatus localStatus;
-    MStatus* st = status ? status : &localStatus;
-    MArrayDataBuilder builder = arrayHandle.builder(st);
-    if (!*st) {
-        return {MDataHandle(), builder};
+    MStatus st;
+    MArrayDataBuilder builder = arrayHandle.builder(statusArg<Status>(st));
+    if (!reportStatus(status, st, "Could not get the array builder")) {
+        return {MDataHandle(), builder, false};
     }
 
-    MDataHandle parhandle = builder.addElement(index, st);
+    MDataHandle parhandle = builder.addElement(index, statusArg<Status>(st));
 
-    if (!*st) {
-        return {MDataHandle(), builder};
+    if (!reportStatus(status, st, "Could not add an element to the array builder")) {
+        return {MDataHandle(), builder, false};
     }
 
     MDataHandle childhandle = getHandleChildren(parhandle, children);
     return {childhandle, builder};
 }
 
+template <typename Status = MStatus*, typename = ErrorPolicyT<Status>>
 inline HandleBuilder buildOutputArrayHandleChildren(
     MDataBlock& block, MObject& arrayAttr, unsigned int index, const std::vector<MObject>& children,
-    MStatus* status=nullptr
+    Status status=nullptr
 ) {
     MArrayDataHandle arrayHandle = block.outputArrayValue(arrayAttr);
     // Ignore the prev status. so I don't have to construct an MArrayDataBuilder
     return buildArrayHandleChildren(arrayHandle, index, children, status);
 }
 
+template <typename Status = MStatus*, typename = ErrorPolicyT<Status>>
 inline HandleBuilder buildInputArrayHandleChildren(
     MDataBlock& block, MObject& arrayAttr, unsigned int index, const std::vector<MObject>& children,
-    MStatus* status=nullptr
+    Status status=nullptr
 ) {
     MArrayDataHandle arrayHandle = block.inputArrayValue(arrayAttr);
     // Ignore the prev status. so I don't have to construct an MArrayDataBuilder
     return buildArrayHandleChildren(arrayHandle, index, children, status);
 }
 
-template <typename T>
+template <typename T, typename Status = MStatus*, typename = ErrorPolicyT<Status>>
 inline MDataHandle setHandleArrayData(
     MArrayDataHandle& arrayHandle, unsigned int index, const std::vector<MObject>& children,
-    T& value, MStatus* status=nullptr
+    T& value, Status status=nullptr
 ) {
-    using FnSet = FnSetTypeT<T>;
-    MStatus localStatus;
-    MStatus* st = status ? status : &localStatus;
-    auto [handle, builder] = buildArrayHandleChildren(arrayHandle, index, children, st);
-    if (!*st) {
+    MStatus st;
+    auto [handle, builder, ok] = buildArrayHandleChildren(arrayHandle, index, children, status);
+    if (!ok) {
         return handle;
     }
 
     // TODO: write a setter that works with both typed data, and simple data
 
-    // Create a new typed data object with the correct function set
-    FnSet fnData;
-    MObject dataObj = fnData.create(st);
-    if (!*st) {
-        return handle;
-    }
+    if constexpr (IsOwnedPluginDataV<T>) {
+        // Hand the plugin data over to the data block, which owns it from here on. No copy
+        st = handle.set(value.get());
+        if (!reportStatus(status, st, "Could not set the plugin data")) {
+            return handle;
+        }
+        value.release();
+    } else {
+        // Create a new typed data object with the correct function set
+        FnSetTypeT<T> fnData;
+        MObject dataObj = fnData.create(statusArg<Status>(st));
+        if (!reportStatus(status, st, "Could not create the output data object")) {
+            return handle;
+        }
 
-    // Set the value
-    fnData.set(value);
+        // Set the value
+        fnData.set(value);
 
-    // Store the object on the element
-    handle.set(dataObj);
+        // Store the object on the element
+        handle.set(dataObj);
+    }
     handle.setClean();
 
     // Reassign builder to array handle
-    *st = arrayHandle.set(builder);
-    if (!*st) {
+    st = arrayHandle.set(builder);
+    if (!reportStatus(status, st, "Could not set the array builder")) {
         return handle;
     }
-    *st = arrayHandle.setClean();
-    if (!*st) {
+    st = arrayHandle.setClean();
+    if (!reportStatus(status, st, "Could not set the array handle clean")) {
         return handle;
     }
     return handle;
 }
 
-template <typename T>
+template <typename T, typename Status = MStatus*, typename = ErrorPolicyT<Status>>
 inline MDataHandle setOutputArrayData(
     MDataBlock& block, MObject& parAttr, unsigned int index, const std::vector<MObject>& children,
-    T& value, MStatus* status=nullptr
+    T& value, Status status=nullptr
 ) {
-    MStatus localStatus;
-    MStatus* st = status ? status : &localStatus;
-    MArrayDataHandle arrayHandle = block.outputArrayValue(parAttr, st);
-    if (!*st) {
+    MStatus st;
+    MArrayDataHandle arrayHandle = block.outputArrayValue(parAttr, statusArg<Status>(st));
+    if (!reportStatus(status, st, "Could not get the output array handle")) {
         return MDataHandle();
     }
-    return setHandleArrayData(arrayHandle, index, children, value, st);
+    return setHandleArrayData(arrayHandle, index, children, value, status);
 }
 
 // This probably shouldn't ever be used, but I'm keeping it for completeness
-template <typename T>
+template <typename T, typename Status = MStatus*, typename = ErrorPolicyT<Status>>
 inline MDataHandle setInputArrayData(
     MDataBlock& block, MObject& parAttr, unsigned int index, const std::vector<MObject>& children,
-    T& value, MStatus* status=nullptr
+    T& value, Status status=nullptr
 ) {
-    MStatus localStatus;
-    MStatus* st = status ? status : &localStatus;
-    MArrayDataHandle arrayHandle = block.inputArrayValue(parAttr, st);
-    if (!*st) {
+    MStatus st;
+    MArrayDataHandle arrayHandle = block.inputArrayValue(parAttr, statusArg<Status>(st));
+    if (!reportStatus(status, st, "Could not get the input array handle")) {
         return MDataHandle();
     }
-    return setHandleArrayData(arrayHandle, index, children, value, st);
+    return setHandleArrayData(arrayHandle, index, children, value, status);
 }
 
 /************************************
 Templates for reading typed data from a handle
 ************************************/
 
-template <typename T>
+template <typename T, typename Status = MStatus*, typename = ErrorPolicyT<Status>>
 inline void getInputArrayData(
     MDataBlock& block, MObject& arrayAttr, unsigned int multiIndex,
-    const std::vector<MObject>& children, T& ret, MStatus* status=nullptr
+    const std::vector<MObject>& children, T& ret, Status status=nullptr
 ) {
-    MStatus localStatus;
-    MStatus* st = status ? status : &localStatus;
-    MArrayDataHandle parArrayHandle = block.inputArrayValue(arrayAttr, st);
-    if (!*st) {
+    MStatus st;
+    MArrayDataHandle parArrayHandle = block.inputArrayValue(arrayAttr, statusArg<Status>(st));
+    if (!reportStatus(status, st, "Could not get the input array handle")) {
         return;
     }
-    *st = parArrayHandle.jumpToElement(multiIndex);
-    if (!*st) {
+    st = parArrayHandle.jumpToElement(multiIndex);
+    if (!reportStatus(status, st, "Could not jump to the array element")) {
         return;
     }
-    MDataHandle handle = parArrayHandle.inputValue(st);
-    if (!*st) {
+    MDataHandle handle = parArrayHandle.inputValue(statusArg<Status>(st));
+    if (!reportStatus(status, st, "Could not get the array element input value")) {
         return;
     }
     for (const MObject& childAttr : children) {
         handle = handle.child(childAttr);
     }
-    ret = DefaultHandleValueGetter<T>()(handle, st);
+    ret = getElementValue(DefaultHandleValueGetter<T>(), handle, status);
 }
 
-template <typename T>
+template <typename T, typename Status = MStatus*, typename = ErrorPolicyT<Status>>
 inline void getOutputArrayData(
     MDataBlock& block, MObject& arrayAttr, unsigned int multiIndex,
-    const std::vector<MObject>& children, T& ret, MStatus* status=nullptr
+    const std::vector<MObject>& children, T& ret, Status status=nullptr
 ) {
-    MStatus localStatus;
-    MStatus* st = status ? status : &localStatus;
-    MArrayDataHandle parArrayHandle = block.outputArrayValue(arrayAttr, st);
-    if (!*st) {
+    MStatus st;
+    MArrayDataHandle parArrayHandle = block.outputArrayValue(arrayAttr, statusArg<Status>(st));
+    if (!reportStatus(status, st, "Could not get the output array handle")) {
         return;
     }
-    *st = parArrayHandle.jumpToElement(multiIndex);
-    if (!*st) {
+    st = parArrayHandle.jumpToElement(multiIndex);
+    if (!reportStatus(status, st, "Could not jump to the array element")) {
         return;
     }
-    MDataHandle handle = parArrayHandle.outputValue(st);
-    if (!*st) {
+    MDataHandle handle = parArrayHandle.outputValue(statusArg<Status>(st));
+    if (!reportStatus(status, st, "Could not get the array element output value")) {
         return;
     }
     for (const MObject& childAttr : children) {
         handle = handle.child(childAttr);
     }
-    ret = DefaultHandleValueGetter<T>()(handle, st);
+    ret = getElementValue(DefaultHandleValueGetter<T>(), handle, status);
 }
 
-template <typename T>
-inline void getMObjHandleData(MDataHandle& handle, T& value, MStatus* status=nullptr) {
-    value = DefaultHandleValueGetter<T>()(handle, status);
+template <typename T, typename Status = MStatus*, typename = ErrorPolicyT<Status>>
+inline void getMObjHandleData(MDataHandle& handle, T& value, Status status=nullptr) {
+    value = getElementValue(DefaultHandleValueGetter<T>(), handle, status);
 }
 
 /************************************
@@ -594,16 +950,104 @@ inline auto appender(ArrayType& outArray, ValueType& val)
 
 // maya array .length
 template <typename ArrayType>
-inline auto getlen(ArrayType& array) -> decltype(std::declval<ArrayType>().length(), void()) {
+inline auto getlen(ArrayType& array) -> decltype(std::declval<ArrayType>().length()) {
     return array.length();
 }
 
 // STL vector .size
 template <typename ArrayType>
-inline auto getlen(ArrayType& array) -> decltype(std::declval<ArrayType>().size(), void()) {
-    array.size();
+inline auto getlen(ArrayType& array) -> decltype(std::declval<ArrayType>().size()) {
+    return array.size();
+}
+
+// maya array .setLength
+template <typename ArrayType>
+inline auto resizer(ArrayType& array, unsigned int size)
+    -> decltype(std::declval<ArrayType>().setLength(size), void()) {
+    array.setLength(size);
+}
+
+// STL vector .resize
+template <typename ArrayType>
+inline auto resizer(ArrayType& array, unsigned int size)
+    -> decltype(std::declval<ArrayType>().resize(size), void()) {
+    array.resize(size);
+}
+
+/************************************
+Index bitset (one bit per array index)
+*************************************
+Used as the presence mask for the full getters, so a kernel can tell real values from the
+defaults that were filled in, at one bit per element.
+************************************/
+
+inline unsigned int countTrailingZeros(std::uint64_t word) {
+#if defined(_MSC_VER)
+    unsigned long ret;
+    _BitScanForward64(&ret, word);
+    return static_cast<unsigned int>(ret);
+#else
+    return static_cast<unsigned int>(__builtin_ctzll(word));
+#endif
+}
+
+inline unsigned int popCount(std::uint64_t word) {
+#if defined(_MSC_VER)
+    return static_cast<unsigned int>(__popcnt64(word));
+#else
+    return static_cast<unsigned int>(__builtin_popcountll(word));
+#endif
+}
+
+// Call func(index) for every set bit of a packed word array, in increasing order
+template <typename Func>
+inline void forEachSetBit(const std::uint64_t* words, std::size_t wordCount, Func func) {
+    for (std::size_t w = 0; w < wordCount; ++w) {
+        std::uint64_t word = words[w];
+        while (word) {
+            func(static_cast<unsigned int>(w * 64 + countTrailingZeros(word)));
+            word &= word - 1;
+        }
+    }
 }
 
+// A packed one-bit-per-index set
+class IndexBitset {
+   public:
+    // Resize and clear every bit
+    void reset(unsigned int size) {
+        m_size = size;
+        m_words.assign((std::size_t(size) + 63) / 64, 0);
+    }
+    void clear() { reset(0); }
+
+    unsigned int size() const { return m_size; }
+    const std::vector<std::uint64_t>& words() const { return m_words; }
+
+    void set(unsigned int index) { m_words[index >> 6] |= std::uint64_t(1) << (index & 63); }
+    bool test(unsigned int index) const {
+        return index < m_size && ((m_words[index >> 6] >> (index & 63)) & 1);
+    }
+
+    // The number of set bits
+    unsigned int count() const {
+        unsigned int ret = 0;
+        for (std::uint64_t word : m_words) {
+            ret += popCount(word);
+        }
+        return ret;
+    }
+
+    template <typename Func>
+    void forEachSetBit(Func func) const {
+        maya_node_utils::forEachSetBit(m_words.data(), m_words.size(), func);
+    }
+
+   private:
+    std::vector<std::uint64_t> m_words;
+    unsigned int m_size = 0;
+};
+
 /************************************
 Compact index getter templates (get vector of values skipping non-existent handle values, and an
 index array)
@@ -618,13 +1062,15 @@ inline void getCompactIndexArrayMultiHandleData(
     }
 }
 
-template <typename T, typename IDXS, typename ValueGetter = DefaultHandleValueGetter<ETypeT<T>>>
+template <
+    typename T, typename IDXS, typename ValueGetter = DefaultHandleValueGetter<ETypeT<T>>,
+    typename Status = MStatus*, typename = ErrorPolicyT<Status>>
 inline void getCompactIndexArrayHandleData(
-    MArrayDataHandle& arrayHandle, T& ret, IDXS& idxs, MStatus* status=nullptr,
+    MArrayDataHandle& arrayHandle, T& ret, IDXS& idxs, Status status=nullptr,
     ValueGetter valueGetter = ValueGetter()
 ) {
     auto valuePusher = [&](unsigned int index, MDataHandle& handle) {
-        auto gg = valueGetter(handle, status);
+        auto gg = getElementValue(valueGetter, handle, status);
         appender(ret, gg);
         appender(idxs, index);
     };
@@ -632,34 +1078,48 @@ inline void getCompactIndexArrayHandleData(
     getCompactIndexArrayMultiHandleData(arrayHandle, valuePusher);
 }
 
-template <typename T, typename IDXS, typename ValueGetter = DefaultHandleValueGetter<ETypeT<T>>>
+template <
+    typename T, typename IDXS, typename ValueGetter = DefaultHandleValueGetter<ETypeT<T>>,
+    typename Status = MStatus*, typename = ErrorPolicyT<Status>>
 inline void getCompactIndexArrayHandleData(
-    MDataBlock& dataBlock, MObject& attr, T& ret, IDXS& idxs,
+    MDataBlock& dataBlock, MObject& attr, T& ret, IDXS& idxs, Status status=nullptr,
     ValueGetter valueGetter = ValueGetter()
 ) {
-    MArrayDataHandle arrayHandle = dataBlock.inputArrayValue(attr);
-    getCompactIndexArrayHandleData(arrayHandle, ret, idxs, valueGetter);
+    MStatus st;
+    MArrayDataHandle arrayHandle = dataBlock.inputArrayValue(attr, statusArg<Status>(st));
+    if (!reportStatus(status, st, "Could not get the input array handle")) {
+        return;
+    }
+    getCompactIndexArrayHandleData(arrayHandle, ret, idxs, status, valueGetter);
 }
 
-template <typename T, typename IDXS, typename ValueGetter = DefaultHandleValueGetter<ETypeT<T>>>
+template <
+    typename T, typename IDXS, typename ValueGetter = DefaultHandleValueGetter<ETypeT<T>>,
+    typename Status = MStatus*, typename = ErrorPolicyT<Status>>
 inline void getCompactIndexArrayHandleData(
     MArrayDataHandle& arrayHandle, const std::vector<MObject>& children, T& ret, IDXS& idxs,
-    MStatus* status=nullptr, ValueGetter valueGetter = ValueGetter()
+    Status status=nullptr, ValueGetter valueGetter = ValueGetter()
 ) {
-    auto childValueGetter = [&](MDataHandle& h, MStatus* status=nullptr) {
+    auto childValueGetter = [&](MDataHandle& h, MStatus* elementStatus=nullptr) {
         MDataHandle childh = getHandleChildren(h, children);
-        return valueGetter(childh, status);
+        return valueGetter(childh, elementStatus);
     };
-    getCompactIndexArrayHandleData(arrayHandle, ret, idxs, childValueGetter);
+    getCompactIndexArrayHandleData(arrayHandle, ret, idxs, status, childValueGetter);
 }
 
-template <typename T, typename IDXS, typename ValueGetter = DefaultHandleValueGetter<ETypeT<T>>>
+template <
+    typename T, typename IDXS, typename ValueGetter = DefaultHandleValueGetter<ETypeT<T>>,
+    typename Status = MStatus*, typename = ErrorPolicyT<Status>>
 inline void getCompactIndexArrayHandleData(
     MDataBlock& dataBlock, MObject& attr, const std::vector<MObject>& children, T& ret, IDXS& idxs,
-    ValueGetter valueGetter = ValueGetter()
+    Status status=nullptr, ValueGetter valueGetter = ValueGetter()
 ) {
-    MArrayDataHandle handle = dataBlock.inputArrayValue(attr);
-    getCompactIndexArrayHandleData(handle, children, ret, idxs, valueGetter);
+    MStatus st;
+    MArrayDataHandle handle = dataBlock.inputArrayValue(attr, statusArg<Status>(st));
+    if (!reportStatus(status, st, "Could not get the input array handle")) {
+        return;
+    }
+    getCompactIndexArrayHandleData(handle, children, ret, idxs, status, valueGetter);
 }
 
 /************************************
@@ -673,45 +1133,62 @@ inline void getCompactArrayMultiHandleData(MArrayDataHandle& arrayHandle, ValueP
     }
 }
 
-template <typename T, typename ValueGetter = DefaultHandleValueGetter<ETypeT<T>>>
+template <
+    typename T, typename ValueGetter = DefaultHandleValueGetter<ETypeT<T>>,
+    typename Status = MStatus*, typename = ErrorPolicyT<Status>>
 inline void getCompactArrayHandleData(
-    MArrayDataHandle& arrayHandle, T& ret, MStatus* status=nullptr, ValueGetter valueGetter = ValueGetter()
+    MArrayDataHandle& arrayHandle, T& ret, Status status=nullptr, ValueGetter valueGetter = ValueGetter()
 ) {
     auto valuePusher = [&](unsigned int index, MDataHandle& handle) {
-        auto gg = valueGetter(handle, status);
+        auto gg = getElementValue(valueGetter, handle, status);
         appender(ret, gg);
     };
 
     getCompactArrayMultiHandleData(arrayHandle, valuePusher);
 }
 
-template <typename T, typename ValueGetter = DefaultHandleValueGetter<ETypeT<T>>>
+template <
+    typename T, typename ValueGetter = DefaultHandleValueGetter<ETypeT<T>>,
+    typename Status = MStatus*, typename = ErrorPolicyT<Status>>
 inline void getCompactArrayHandleData(
-    MDataBlock& dataBlock, MObject& attr, T& ret, ValueGetter valueGetter = ValueGetter()
+    MDataBlock& dataBlock, MObject& attr, T& ret, Status status=nullptr,
+    ValueGetter valueGetter = ValueGetter()
 ) {
-    MArrayDataHandle arrayHandle = dataBlock.inputArrayValue(attr);
-    getCompactArrayHandleData(arrayHandle, ret, valueGetter);
+    MStatus st;
+    MArrayDataHandle arrayHandle = dataBlock.inputArrayValue(attr, statusArg<Status>(st));
+    if (!reportStatus(status, st, "Could not get the input array handle")) {
+        return;
+    }
+    getCompactArrayHandleData(arrayHandle, ret, status, valueGetter);
 }
 
-template <typename T, typename ValueGetter = DefaultHandleValueGetter<ETypeT<T>>>
+template <
+    typename T, typename ValueGetter = DefaultHandleValueGetter<ETypeT<T>>,
+    typename Status = MStatus*, typename = ErrorPolicyT<Status>>
 inline void getCompactArrayHandleData(
-    MArrayDataHandle& arrayHandle, const std::vector<MObject>& children, T& ret, MStatus* status=nullptr,
+    MArrayDataHandle& arrayHandle, const std::vector<MObject>& children, T& ret, Status status=nullptr,
     ValueGetter valueGetter = ValueGetter()
 ) {
-    auto childValueGetter = [&](MDataHandle& h, MStatus* status=nullptr) {
+    auto childValueGetter = [&](MDataHandle& h, MStatus* elementStatus=nullptr) {
         MDataHandle childh = getHandleChildren(h, children);
-        return valueGetter(childh, status);
+        return valueGetter(childh, elementStatus);
     };
-    getCompactArrayHandleData(arrayHandle, ret, childValueGetter);
+    getCompactArrayHandleData(arrayHandle, ret, status, childValueGetter);
 }
 
-template <typename T, typename ValueGetter = DefaultHandleValueGetter<ETypeT<T>>>
+template <
+    typename T, typename ValueGetter = DefaultHandleValueGetter<ETypeT<T>>,
+    typename Status = MStatus*, typename = ErrorPolicyT<Status>>
 inline void getCompactArrayHandleData(
     MDataBlock& dataBlock, MObject& attr, const std::vector<MObject>& children, T& ret,
-    ValueGetter valueGetter = ValueGetter()
+    Status status=nullptr, ValueGetter valueGetter = ValueGetter()
 ) {
-    MArrayDataHandle handle = dataBlock.inputArrayValue(attr);
-    getCompactArrayHandleData(handle, children, ret, valueGetter);
+    MStatus st;
+    MArrayDataHandle handle = dataBlock.inputArrayValue(attr, statusArg<Status>(st));
+    if (!reportStatus(status, st, "Could not get the input array handle")) {
+        return;
+    }
+    getCompactArrayHandleData(handle, children, ret, status, valueGetter);
 }
 
 /************************************
@@ -738,13 +1215,15 @@ inline void getFullArrayMultiHandleData(
     }
 }
 
-template <typename T, typename ValueGetter = DefaultHandleValueGetter<ETypeT<T>>>
+template <
+    typename T, typename ValueGetter = DefaultHandleValueGetter<ETypeT<T>>,
+    typename Status = MStatus*, typename = ErrorPolicyT<Status>>
 inline void getFullArrayHandleData(
-    MArrayDataHandle& arrayHandle, T& ret, unsigned int minSize, MStatus* status=nullptr,
+    MArrayDataHandle& arrayHandle, T& ret, unsigned int minSize, Status status=nullptr,
     ValueGetter valueGetter = ValueGetter()
 ) {
     auto valuePusher = [&](unsigned int index, MDataHandle& handle) {
-        auto gg = valueGetter(handle, status);
+        auto gg = getElementValue(valueGetter, handle, status);
         appender(ret, gg);
     };
 
@@ -753,70 +1232,205 @@ inline void getFullArrayHandleData(
     getFullArrayMultiHandleData(arrayHandle, minSize, defaultPusher, valuePusher);
 }
 
-template <typename T, typename ValueGetter = DefaultHandleValueGetter<ETypeT<T>>>
+template <
+    typename T, typename ValueGetter = DefaultHandleValueGetter<ETypeT<T>>,
+    typename Status = MStatus*, typename = ErrorPolicyT<Status>>
 inline void getFullArrayHandleData(
-    MDataBlock& dataBlock, MObject& attr, T& ret, unsigned int minSize, MStatus* status=nullptr,
+    MDataBlock& dataBlock, MObject& attr, T& ret, unsigned int minSize, Status status=nullptr,
     ValueGetter valueGetter = ValueGetter()
 ) {
-    MArrayDataHandle arrayHandle = dataBlock.inputArrayValue(attr);
-    getFullArrayHandleData(arrayHandle, ret, minSize, valueGetter);
+    MStatus st;
+    MArrayDataHandle arrayHandle = dataBlock.inputArrayValue(attr, statusArg<Status>(st));
+    if (!reportStatus(status, st, "Could not get the input array handle")) {
+        return;
+    }
+    getFullArrayHandleData(arrayHandle, ret, minSize, status, valueGetter);
 }
 
-template <typename T, typename ValueGetter = DefaultHandleValueGetter<ETypeT<T>>>
+template <
+    typename T, typename ValueGetter = DefaultHandleValueGetter<ETypeT<T>>,
+    typename Status = MStatus*, typename = ErrorPolicyT<Status>>
 inline void getFullArrayHandleData(
     MArrayDataHandle& arrayHandle, const std::vector<MObject>& children, T& ret,
-    unsigned int minSize, MStatus* status=nullptr, ValueGetter valueGetter = ValueGetter()
+    unsigned int minSize, Status status=nullptr, ValueGetter valueGetter = ValueGetter()
 ) {
-    auto childValueGetter = [&](MDataHandle& h, MStatus* status=nullptr) {
+    auto childValueGetter = [&](MDataHandle& h, MStatus* elementStatus=nullptr) {
         MDataHandle childh = getHandleChildren(h, children);
-        return valueGetter(childh, status);
+        return valueGetter(childh, elementStatus);
     };
     getFullArrayHandleData(arrayHandle, ret, minSize, status, childValueGetter);
 }
 
-template <typename T, typename ValueGetter = DefaultHandleValueGetter<ETypeT<T>>>
+template <
+    typename T, typename ValueGetter = DefaultHandleValueGetter<ETypeT<T>>,
+    typename Status = MStatus*, typename = ErrorPolicyT<Status>>
 inline void getFullArrayHandleData(
     MDataBlock& dataBlock, MObject& attr, const std::vector<MObject>& children, T& ret,
-    unsigned int minSize, MStatus* status=nullptr, ValueGetter valueGetter = ValueGetter()
+    unsigned int minSize, Status status=nullptr, ValueGetter valueGetter = ValueGetter()
 ) {
-    MArrayDataHandle handle = dataBlock.inputArrayValue(attr);
+    MStatus st;
+    MArrayDataHandle handle = dataBlock.inputArrayValue(attr, statusArg<Status>(st));
+    if (!reportStatus(status, st, "Could not get the input array handle")) {
+        return;
+    }
     getFullArrayHandleData(handle, children, ret, minSize, status, valueGetter);
 }
 
 /////
 // Full getter templates with a default minsize of 0
 /////
-template <typename T, typename ValueGetter = DefaultHandleValueGetter<ETypeT<T>>>
+template <
+    typename T, typename ValueGetter = DefaultHandleValueGetter<ETypeT<T>>,
+    typename Status = MStatus*, typename = ErrorPolicyT<Status>>
 inline void getFullArrayHandleData(
-    MArrayDataHandle& arrayHandle, T& ret, MStatus* status=nullptr, ValueGetter valueGetter = ValueGetter()
+    MArrayDataHandle& arrayHandle, T& ret, Status status=nullptr, ValueGetter valueGetter = ValueGetter()
 ) {
     getFullArrayHandleData(arrayHandle, ret, 0, status, valueGetter);
 }
 
-template <typename T, typename ValueGetter = DefaultHandleValueGetter<ETypeT<T>>>
+template <
+    typename T, typename ValueGetter = DefaultHandleValueGetter<ETypeT<T>>,
+    typename Status = MStatus*, typename = ErrorPolicyT<Status>>
 inline void getFullArrayHandleData(
-    MDataBlock& dataBlock, MObject& attr, T& ret, MStatus* status=nullptr,
+    MDataBlock& dataBlock, MObject& attr, T& ret, Status status=nullptr,
     ValueGetter valueGetter = ValueGetter()
 ) {
     getFullArrayHandleData(dataBlock, attr, ret, 0, status, valueGetter);
 }
 
-template <typename T, typename ValueGetter = DefaultHandleValueGetter<ETypeT<T>>>
+template <
+    typename T, typename ValueGetter = DefaultHandleValueGetter<ETypeT<T>>,
+    typename Status = MStatus*, typename = ErrorPolicyT<Status>>
 inline void getFullArrayHandleData(
-    MArrayDataHandle& arrayHandle, const std::vector<MObject>& children, T& ret, MStatus* status=nullptr,
+    MArrayDataHandle& arrayHandle, const std::vector<MObject>& children, T& ret, Status status=nullptr,
     ValueGetter valueGetter = ValueGetter()
 ) {
     getFullArrayHandleData(arrayHandle, children, ret, 0, status, valueGetter);
 }
 
-template <typename T, typename ValueGetter = DefaultHandleValueGetter<ETypeT<T>>>
+template <
+    typename T, typename ValueGetter = DefaultHandleValueGetter<ETypeT<T>>,
+    typename Status = MStatus*, typename = ErrorPolicyT<Status>>
 inline void getFullArrayHandleData(
     MDataBlock& dataBlock, MObject& attr, const std::vector<MObject>& children, T& ret,
-    MStatus* status=nullptr, ValueGetter valueGetter = ValueGetter()
+    Status status=nullptr, ValueGetter valueGetter = ValueGetter()
 ) {
     getFullArrayHandleData(dataBlock, attr, children, ret, 0, status, valueGetter);
 }
 
+/////
+// Full getter templates that also fill a presence bitset
+// A bit is set for every index that actually exists on the plug, and clear where a default
+// was filled in
+/////
+template <
+    typename T, typename ValueGetter = DefaultHandleValueGetter<ETypeT<T>>,
+    typename Status = MStatus*, typename = ErrorPolicyT<Status>>
+inline void getFullArrayHandleData(
+    MArrayDataHandle& arrayHandle, T& ret, IndexBitset& presence, unsigned int minSize,
+    Status status=nullptr, ValueGetter valueGetter = ValueGetter()
+) {
+    presence.reset(std::max(getArrayLogicalSize(arrayHandle), minSize));
+
+    auto valuePusher = [&](unsigned int index, MDataHandle& handle) {
+        auto gg = getElementValue(valueGetter, handle, status);
+        appender(ret, gg);
+        presence.set(index);
+    };
+
+    auto defaultPusher = [&ret](unsigned int index) { defaulter(ret); };
+
+    getFullArrayMultiHandleData(arrayHandle, minSize, defaultPusher, valuePusher);
+}
+
+template <
+    typename T, typename ValueGetter = DefaultHandleValueGetter<ETypeT<T>>,
+    typename Status = MStatus*, typename = ErrorPolicyT<Status>>
+inline void getFullArrayHandleData(
+    MDataBlock& dataBlock, MObject& attr, T& ret, IndexBitset& presence, unsigned int minSize,
+    Status status=nullptr, ValueGetter valueGetter = ValueGetter()
+) {
+    MStatus st;
+    MArrayDataHandle arrayHandle = dataBlock.inputArrayValue(attr, statusArg<Status>(st));
+    if (!reportStatus(status, st, "Could not get the input array handle")) {
+        presence.clear();
+        return;
+    }
+    getFullArrayHandleData(arrayHandle, ret, presence, minSize, status, valueGetter);
+}
+
+template <
+    typename T, typename ValueGetter = DefaultHandleValueGetter<ETypeT<T>>,
+    typename Status = MStatus*, typename = ErrorPolicyT<Status>>
+inline void getFullArrayHandleData(
+    MArrayDataHandle& arrayHandle, const std::vector<MObject>& children, T& ret,
+    IndexBitset& presence, unsigned int minSize, Status status=nullptr,
+    ValueGetter valueGetter = ValueGetter()
+) {
+    auto childValueGetter = [&](MDataHandle& h, MStatus* elementStatus=nullptr) {
+        MDataHandle childh = getHandleChildren(h, children);
+        return valueGetter(childh, elementStatus);
+    };
+    getFullArrayHandleData(arrayHandle, ret, presence, minSize, status, childValueGetter);
+}
+
+template <
+    typename T, typename ValueGetter = DefaultHandleValueGetter<ETypeT<T>>,
+    typename Status = MStatus*, typename = ErrorPolicyT<Status>>
+inline void getFullArrayHandleData(
+    MDataBlock& dataBlock, MObject& attr, const std::vector<MObject>& children, T& ret,
+    IndexBitset& presence, unsigned int minSize, Status status=nullptr,
+    ValueGetter valueGetter = ValueGetter()
+) {
+    MStatus st;
+    MArrayDataHandle handle = dataBlock.inputArrayValue(attr, statusArg<Status>(st));
+    if (!reportStatus(status, st, "Could not get the input array handle")) {
+        presence.clear();
+        return;
+    }
+    getFullArrayHandleData(handle, children, ret, presence, minSize, status, valueGetter);
+}
+
+template <
+    typename T, typename ValueGetter = DefaultHandleValueGetter<ETypeT<T>>,
+    typename Status = MStatus*, typename = ErrorPolicyT<Status>>
+inline void getFullArrayHandleData(
+    MArrayDataHandle& arrayHandle, T& ret, IndexBitset& presence, Status status=nullptr,
+    ValueGetter valueGetter = ValueGetter()
+) {
+    getFullArrayHandleData(arrayHandle, ret, presence, 0, status, valueGetter);
+}
+
+template <
+    typename T, typename ValueGetter = DefaultHandleValueGetter<ETypeT<T>>,
+    typename Status = MStatus*, typename = ErrorPolicyT<Status>>
+inline void getFullArrayHandleData(
+    MDataBlock& dataBlock, MObject& attr, T& ret, IndexBitset& presence, Status status=nullptr,
+    ValueGetter valueGetter = ValueGetter()
+) {
+    getFullArrayHandleData(dataBlock, attr, ret, presence, 0, status, valueGetter);
+}
+
+template <
+    typename T, typename ValueGetter = DefaultHandleValueGetter<ETypeT<T>>,
+    typename Status = MStatus*, typename = ErrorPolicyT<Status>>
+inline void getFullArrayHandleData(
+    MArrayDataHandle& arrayHandle, const std::vector<MObject>& children, T& ret,
+    IndexBitset& presence, Status status=nullptr, ValueGetter valueGetter = ValueGetter()
+) {
+    getFullArrayHandleData(arrayHandle, children, ret, presence, 0, status, valueGetter);
+}
+
+template <
+    typename T, typename ValueGetter = DefaultHandleValueGetter<ETypeT<T>>,
+    typename Status = MStatus*, typename = ErrorPolicyT<Status>>
+inline void getFullArrayHandleData(
+    MDataBlock& dataBlock, MObject& attr, const std::vector<MObject>& children, T& ret,
+    IndexBitset& presence, Status status=nullptr, ValueGetter valueGetter = ValueGetter()
+) {
+    getFullArrayHandleData(dataBlock, attr, children, ret, presence, 0, status, valueGetter);
+}
+
 /************************************
 Sparse getter templates  (get unordered_map keyed on indices)
 ************************************/
@@ -827,37 +1441,1625 @@ inline void getSparseArrayMultiHandleData(MArrayDataHandle& arrayHandle, ValuePu
     }
 }
 
-template <typename Map, typename T=typename Map::mapped_type, typename ValueGetter = DefaultHandleValueGetter<T>>
+template <
+    typename Map, typename T = typename Map::mapped_type, typename ValueGetter = DefaultHandleValueGetter<T>,
+    typename Status = MStatus*, typename = ErrorPolicyT<Status>>
 inline void getSparseArrayHandleData(
-    MArrayDataHandle& arrayHandle, Map& ret, MStatus* status=nullptr,
+    MArrayDataHandle& arrayHandle, Map& ret, Status status=nullptr,
     ValueGetter valueGetter = ValueGetter()
 ) {
     auto valuePusher = [&](unsigned int index, MDataHandle& handle) {
-        ret[index] = valueGetter(handle, status);
+        ret[index] = getElementValue(valueGetter, handle, status);
     };
     getSparseArrayMultiHandleData(arrayHandle, valuePusher);
 }
 
-template <typename Map, typename T=typename Map::mapped_type, typename ValueGetter = DefaultHandleValueGetter<T>>
+template <
+    typename Map, typename T = typename Map::mapped_type, typename ValueGetter = DefaultHandleValueGetter<T>,
+    typename Status = MStatus*, typename = ErrorPolicyT<Status>>
+inline void getSparseArrayHandleData(
+    MDataBlock& dataBlock, MObject& attr, Map& ret, Status status=nullptr,
+    ValueGetter valueGetter = ValueGetter()
+) {
+    MStatus st;
+    MArrayDataHandle arrayHandle = dataBlock.inputArrayValue(attr, statusArg<Status>(st));
+    if (!reportStatus(status, st, "Could not get the input array handle")) {
+        return;
+    }
+    getSparseArrayHandleData(arrayHandle, ret, status, valueGetter);
+}
+
+template <
+    typename Map, typename T = typename Map::mapped_type, typename ValueGetter = DefaultHandleValueGetter<T>,
+    typename Status = MStatus*, typename = ErrorPolicyT<Status>>
 inline void getSparseArrayHandleData(
     MArrayDataHandle& arrayHandle, const std::vector<MObject>& children,
-    Map& ret, MStatus* status=nullptr,
+    Map& ret, Status status=nullptr,
     ValueGetter valueGetter = ValueGetter()
 ) {
-    auto childValueGetter = [&](MDataHandle& h, MStatus* status=nullptr) {
-        return valueGetter(getHandleChildren(h, children), status);
+    auto childValueGetter = [&](MDataHandle& h, MStatus* elementStatus=nullptr) {
+        MDataHandle childh = getHandleChildren(h, children);
+        return valueGetter(childh, elementStatus);
     };
-    getSparseArrayChildHandleData<T>(arrayHandle, ret, childValueGetter);
+    getSparseArrayHandleData(arrayHandle, ret, status, childValueGetter);
 }
 
-template <typename Map, typename T=typename Map::mapped_type, typename ValueGetter = DefaultHandleValueGetter<T>>
+template <
+    typename Map, typename T = typename Map::mapped_type, typename ValueGetter = DefaultHandleValueGetter<T>,
+    typename Status = MStatus*, typename = ErrorPolicyT<Status>>
 inline void getSparseArrayHandleData(
     MDataBlock& dataBlock, MObject& attr, const std::vector<MObject>& children,
-    Map& ret, ValueGetter valueGetter = ValueGetter()
+    Map& ret, Status status=nullptr, ValueGetter valueGetter = ValueGetter()
 ) {
-    MArrayDataHandle arrayHandle = dataBlock.inputArrayValue(attr);
-    getSparseArrayHandleData<T>(arrayHandle, children, ret, valueGetter);
+    MStatus st;
+    MArrayDataHandle arrayHandle = dataBlock.inputArrayValue(attr, statusArg<Status>(st));
+    if (!reportStatus(status, st, "Could not get the input array handle")) {
+        return;
+    }
+    getSparseArrayHandleData(arrayHandle, children, ret, status, valueGetter);
+}
+
+/************************************
+Joined getter templates (read sibling arrays that share indices in one merge pass)
+*************************************
+For pairs like matrix[]/bindPreMatrix[] or target[]/targetWeight[]. Every array gets walked
+once, in order, side by side, and each output gets one value per joined index.
+
+    std::vector<MMatrix> mats, bpms;
+    std::vector<unsigned int> idxs;
+    getJoinedArrayHandleData(
+        JoinPolicy::Outer, idxs, nullptr,
+        joinInput(dataBlock.inputArrayValue(aMatrix), mats),
+        joinInput(dataBlock.inputArrayValue(aBindPreMatrix), bpms)
+    );
+
+Inner only keeps the indices that exist in every array.
+Outer keeps the indices that exist in any of them, and fills the gaps with default values.
+************************************/
+
+enum class JoinPolicy { Inner, Outer };
+
+// One side of a join. Holds its own copy of the array handle, and a cursor into it
+template <typename T, typename ValueGetter>
+struct JoinInput {
+    MArrayDataHandle handle;
+    T& ret;
+    ValueGetter valueGetter;
+    unsigned int pos = 0;
+    unsigned int count = 0;
+    unsigned int index = 0;
+
+    void start() {
+        pos = 0;
+        count = handle.elementCount();
+        load();
+    }
+    bool done() const { return pos >= count; }
+    // The logical index under the cursor. Finished inputs sort after everything
+    unsigned int current() const { return done() ? ~0u : index; }
+
+    void load() {
+        if (pos < count) {
+            handle.jumpToArrayElement(pos);
+            index = handle.elementIndex();
+        }
+    }
+
+    // Step past the joined index without reading it
+    void skip(unsigned int joinIdx) {
+        if (current() == joinIdx) {
+            ++pos;
+            load();
+        }
+    }
+
+    // Read the value at the joined index, or a default if this input doesn't have it
+    template <typename Status>
+    void take(unsigned int joinIdx, Status status) {
+        if (current() != joinIdx) {
+            defaulter(ret);
+            return;
+        }
+        MDataHandle h = handle.inputValue();
+        auto gg = getElementValue(valueGetter, h, status);
+        appender(ret, gg);
+        ++pos;
+        load();
+    }
+};
+
+template <typename T, typename ValueGetter = DefaultHandleValueGetter<ETypeT<T>>>
+inline JoinInput<T, ValueGetter> joinInput(
+    const MArrayDataHandle& arrayHandle, T& ret, ValueGetter valueGetter = ValueGetter()
+) {
+    return {arrayHandle, ret, valueGetter};
+}
+
+template <typename T, typename ValueGetter = DefaultHandleValueGetter<ETypeT<T>>>
+inline auto joinInput(
+    const MArrayDataHandle& arrayHandle, const std::vector<MObject>& children, T& ret,
+    ValueGetter valueGetter = ValueGetter()
+) {
+    // Capture by value, the input outlives this call
+    auto childValueGetter = [children, valueGetter](MDataHandle& h, MStatus* elementStatus=nullptr) {
+        MDataHandle childh = getHandleChildren(h, children);
+        return valueGetter(childh, elementStatus);
+    };
+    return JoinInput<T, decltype(childValueGetter)>{arrayHandle, ret, childValueGetter};
+}
+
+// Walk all the inputs together, filling idxs with the joined logical indices
+template <typename IDXS, typename Status, typename = ErrorPolicyT<Status>, typename... Inputs>
+inline void getJoinedArrayHandleData(
+    JoinPolicy policy, IDXS& idxs, Status status, Inputs... inputs
+) {
+    static_assert(sizeof...(Inputs) > 0, "Need at least one array to join");
+    (inputs.start(), ...);
+    while (true) {
+        if ((inputs.done() && ...)) {
+            break;
+        }
+        if (policy == JoinPolicy::Inner && (inputs.done() || ...)) {
+            break;
+        }
+        unsigned int index = std::min({inputs.current()...});
+        if (policy == JoinPolicy::Inner && !((inputs.current() == index) && ...)) {
+            // Not in every array, so nothing to emit
+            (inputs.skip(index), ...);
+            continue;
+        }
+        appender(idxs, index);
+        (inputs.take(index, status), ...);
+    }
+}
+
+/************************************
+Mixed precision templates (read double based data as floats, and write floats as doubles)
+*************************************
+NarrowingHandleValueGetter is a drop-in precision policy for the valueGetter slot of any getter
+It reads the double type that's actually stored on the attribute and hands back the float one
+
+    std::vector<MFloatMatrix> mats;
+    getFullArrayHandleData(dataBlock, aMatrix, mats, nullptr, NarrowingHandleValueGetter<MFloatMatrix>());
+
+setWidenedOutputArrayData goes the other way, for writing float data to a double typed output
+
+    setWidenedOutputArrayData<MVectorArray>(dataBlock, aOutVectors, 0, {}, floatVectors);
+************************************/
+
+inline void convertScalars(const double* src, float* dst, std::size_t count) {
+    std::size_t i = 0;
+#if defined(__AVX__)
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_ps(dst + i, _mm256_cvtpd_ps(_mm256_loadu_pd(src + i)));
+    }
+#elif defined(__SSE2__) || defined(_M_X64)
+    for (; i + 2 <= count; i += 2) {
+        _mm_storel_pi(reinterpret_cast<__m64*>(dst + i), _mm_cvtpd_ps(_mm_loadu_pd(src + i)));
+    }
+#endif
+    for (; i < count; ++i) {
+        dst[i] = static_cast<float>(src[i]);
+    }
+}
+
+inline void convertScalars(const float* src, double* dst, std::size_t count) {
+    std::size_t i = 0;
+#if defined(__AVX__)
+    for (; i + 4 <= count; i += 4) {
+        _mm256_storeu_pd(dst + i, _mm256_cvtps_pd(_mm_loadu_ps(src + i)));
+    }
+#elif defined(__SSE2__) || defined(_M_X64)
+    for (; i + 2 <= count; i += 2) {
+        __m128i pair = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i));
+        _mm_storeu_pd(dst + i, _mm_cvtps_pd(_mm_castsi128_ps(pair)));
+    }
+#endif
+    for (; i < count; ++i) {
+        dst[i] = static_cast<double>(src[i]);
+    }
+}
+
+template <typename T> struct IsStdVector : std::false_type {};
+template <typename T, typename Alloc> struct IsStdVector<std::vector<T, Alloc>> : std::true_type {};
+
+// clang-format off
+template <typename T> struct ScalarType;
+template <> struct ScalarType<double>       { using type = double; };
+template <> struct ScalarType<MVector>      { using type = double; };
+template <> struct ScalarType<MPoint>       { using type = double; };
+template <> struct ScalarType<MMatrix>      { using type = double; };
+template <> struct ScalarType<float>        { using type = float;  };
+template <> struct ScalarType<MFloatVector> { using type = float;  };
+template <> struct ScalarType<MFloatPoint>  { using type = float;  };
+template <> struct ScalarType<MFloatMatrix> { using type = float;  };
+template <typename T> using ScalarTypeT = typename ScalarType<T>::type;
+// clang-format on
+
+// The API doesn't say how the maya arrays store their elements, so scalars go in and out of them
+// through the documented bulk accessors: get(double[][3]) and friends to read, and the buffer
+// constructors to write. MMatrixArray has neither, so that goes one matrix at a time
+template <std::size_t Components, typename Scalar, typename ArrayType>
+inline void readScalars(const ArrayType& array, Scalar* dst) {
+    unsigned int count = array.length();
+    if constexpr (std::is_same_v<ArrayType, MMatrixArray>) {
+        for (unsigned int i = 0; i < count; ++i) {
+            std::memcpy(dst + i * Components, &array[i].matrix[0][0], sizeof(Scalar) * Components);
+        }
+    } else if constexpr (Components == 1) {
+        array.get(dst);
+    } else {
+        array.get(reinterpret_cast<Scalar(*)[Components]>(dst));
+    }
 }
+
+template <std::size_t Components, typename Scalar, typename ArrayType>
+inline void writeScalars(ArrayType& array, const Scalar* src, unsigned int count) {
+    if constexpr (std::is_same_v<ArrayType, MMatrixArray>) {
+        array.setLength(count);
+        for (unsigned int i = 0; i < count; ++i) {
+            std::memcpy(&array[i].matrix[0][0], src + i * Components, sizeof(Scalar) * Components);
+        }
+    } else if constexpr (Components == 1) {
+        array = ArrayType(src, count);
+    } else {
+        array = ArrayType(reinterpret_cast<const Scalar(*)[Components]>(src), count);
+    }
+}
+
+// Convert a whole container of double based elements to float based ones, or the other way
+// std::vectors get converted in place, and maya arrays go through a flat scratch buffer
+template <typename Target, typename Source>
+inline void convertArray(const Source& src, Target& ret) {
+    using SourceScalar = ScalarTypeT<ETypeT<Source>>;
+    using TargetScalar = ScalarTypeT<ETypeT<Target>>;
+    constexpr std::size_t components = sizeof(ETypeT<Source>) / sizeof(SourceScalar);
+    static_assert(
+        components * sizeof(TargetScalar) == sizeof(ETypeT<Target>),
+        "Source and target elements need the same number of components"
+    );
+
+    unsigned int count = static_cast<unsigned int>(getlen(src));
+    std::size_t scalarCount = std::size_t(count) * components;
+    if (count == 0) {
+        resizer(ret, 0);
+        return;
+    }
+
+    std::vector<SourceScalar> srcBuffer;
+    const SourceScalar* srcData = nullptr;
+    if constexpr (IsStdVector<Source>::value) {
+        srcData = reinterpret_cast<const SourceScalar*>(src.data());
+    } else {
+        srcBuffer.resize(scalarCount);
+        readScalars<components>(src, srcBuffer.data());
+        srcData = srcBuffer.data();
+    }
+
+    if constexpr (IsStdVector<Target>::value) {
+        ret.resize(count);
+        convertScalars(srcData, reinterpret_cast<TargetScalar*>(ret.data()), scalarCount);
+    } else {
+        std::vector<TargetScalar> dstBuffer(scalarCount);
+        convertScalars(srcData, dstBuffer.data(), scalarCount);
+        writeScalars<components>(ret, dstBuffer.data(), count);
+    }
+}
+
+template <typename T, typename MFnT>
+inline T narrowArray(MDataHandle& handle, MStatus* status=nullptr) {
+    using Source = decltype(std::declval<MFnT>().array());
+    Source src = hg_impl<Source, MFnT>(handle, status);
+    T ret;
+    convertArray(src, ret);
+    return ret;
+}
+
+// Narrow a single value. The source only needs to be laid out like the target, but in doubles
+template <typename T, typename Source>
+inline T narrowValue(const Source& src) {
+    static_assert(sizeof(Source) == sizeof(T) * 2, "Source and target need the same components");
+    T ret;
+    convertScalars(
+        reinterpret_cast<const double*>(&src), reinterpret_cast<float*>(&ret), sizeof(T) / sizeof(float)
+    );
+    return ret;
+}
+
+template <typename T>
+struct NarrowingHandleValueGetter {
+    inline T operator()(MDataHandle& handle, MStatus* status=nullptr) const {
+        // clang-format off
+        if constexpr      (std::is_same_v<T, float>)        { return static_cast<float>(handle.asDouble()); }
+        else if constexpr (std::is_same_v<T, MFloatVector>) { return narrowValue<T>(handle.asVector());     }
+        else if constexpr (std::is_same_v<T, MFloatPoint>)  { return MFloatPoint(narrowValue<MFloatVector>(handle.asVector())); }
+        else if constexpr (std::is_same_v<T, MFloatMatrix>) { return narrowValue<T>(handle.asMatrix());     }
+        else if constexpr (std::is_same_v<T, MFloatArray>)               { return narrowArray<T, MFnDoubleArrayData>(handle, status); }
+        else if constexpr (std::is_same_v<T, std::vector<float>>)        { return narrowArray<T, MFnDoubleArrayData>(handle, status); }
+        else if constexpr (std::is_same_v<T, MFloatVectorArray>)         { return narrowArray<T, MFnVectorArrayData>(handle, status); }
+        else if constexpr (std::is_same_v<T, std::vector<MFloatVector>>) { return narrowArray<T, MFnVectorArrayData>(handle, status); }
+        else if constexpr (std::is_same_v<T, MFloatPointArray>)          { return narrowArray<T, MFnPointArrayData>(handle, status); }
+        else if constexpr (std::is_same_v<T, std::vector<MFloatPoint>>)  { return narrowArray<T, MFnPointArrayData>(handle, status); }
+        else if constexpr (std::is_same_v<T, std::vector<MFloatMatrix>>) { return narrowArray<T, MFnMatrixArrayData>(handle, status); }
+        else { static_assert(false, "Unsupported narrowing type."); }
+        // clang-format on
+    }
+};
+
+// Widen float data to the double based Target array type, then set it like setOutputArrayData
+template <typename Target, typename T, typename Status = MStatus*, typename = ErrorPolicyT<Status>>
+inline MDataHandle setWidenedOutputArrayData(
+    MDataBlock& block, MObject& parAttr, unsigned int index, const std::vector<MObject>& children,
+    const T& value, Status status=nullptr
+) {
+    Target wide;
+    convertArray(value, wide);
+    return setOutputArrayData(block, parAttr, index, children, wide, status);
+}
+
+/************************************
+Lazy array view (only read the indices you ask for)
+*************************************
+For when a compute only touches a handful of indices out of a huge input array.
+Nothing gets read until it's asked for, and the last few lookups are cached.
+
+    LazyArrayHandleView<MMatrix> mats(arrayHandle, MMatrix::identity);
+    MMatrix a = mats[12];
+    MMatrix b = mats.get(40000, otherDefault);
+
+    std::vector<MMatrix> picked;
+    mats.gather(wantedIndices, picked);  // picked[i] is the value at wantedIndices[i]
+************************************/
+
+template <
+    typename T, typename ValueGetter = DefaultHandleValueGetter<T>, typename Status = MStatus*,
+    typename = ErrorPolicyT<Status>>
+class LazyArrayHandleView {
+   public:
+    static constexpr unsigned int cacheSize = 16;
+
+    explicit LazyArrayHandleView(
+        MArrayDataHandle& arrayHandle, T defaultValue = T(), Status status = nullptr,
+        ValueGetter valueGetter = ValueGetter()
+    )
+        : m_handle(arrayHandle),
+          m_default(defaultValue),
+          m_status(status),
+          m_valueGetter(valueGetter) {}
+
+    T operator[](unsigned int logicalIndex) { return get(logicalIndex, m_default); }
+
+    T get(unsigned int logicalIndex, const T& defaultValue) {
+        CacheSlot& slot = m_cache[logicalIndex % cacheSize];
+        if (!slot.valid || slot.index != logicalIndex) {
+            fill(slot, logicalIndex);
+        }
+        return slot.exists ? slot.value : defaultValue;
+    }
+
+    bool has(unsigned int logicalIndex) {
+        CacheSlot& slot = m_cache[logicalIndex % cacheSize];
+        if (!slot.valid || slot.index != logicalIndex) {
+            fill(slot, logicalIndex);
+        }
+        return slot.exists;
+    }
+
+    // Get the values for a whole list of indices at once
+    // The requests get sorted so each unique index is only read once, with one jump straight to
+    // it. The cost only depends on how many indices you ask for. This doesn't touch the cache
+    template <typename IDXS, typename Container>
+    void gather(const IDXS& indices, Container& ret) {
+        unsigned int count = static_cast<unsigned int>(getlen(indices));
+        resizer(ret, count);
+
+        std::vector<unsigned int> order(count);
+        for (unsigned int i = 0; i < count; ++i) {
+            order[i] = i;
+        }
+        std::sort(order.begin(), order.end(), [&indices](unsigned int a, unsigned int b) {
+            return indices[a] < indices[b];
+        });
+
+        unsigned int prevIdx = 0;
+        bool hasPrev = false;
+        T value = m_default;
+        for (unsigned int i : order) {
+            unsigned int logicalIndex = static_cast<unsigned int>(indices[i]);
+            if (!hasPrev || logicalIndex != prevIdx) {
+                // A missing index isn't an error here, so it doesn't go to the policy
+                if (m_handle.jumpToElement(logicalIndex) == MStatus::kSuccess) {
+                    MDataHandle handle = m_handle.inputValue();
+                    value = getElementValue(m_valueGetter, handle, m_status);
+                } else {
+                    value = m_default;
+                }
+                prevIdx = logicalIndex;
+                hasPrev = true;
+            }
+            ret[i] = value;
+        }
+    }
+
+    // Forget everything that's been read. Use this if the view outlives a compute
+    void reset() {
+        for (CacheSlot& slot : m_cache) {
+            slot.valid = false;
+        }
+    }
+
+   private:
+    struct CacheSlot {
+        unsigned int index = 0;
+        bool valid = false;
+        bool exists = false;
+        T value;
+    };
+
+    void fill(CacheSlot& slot, unsigned int logicalIndex) {
+        slot.index = logicalIndex;
+        slot.valid = true;
+        // A missing index isn't an error here, so it doesn't go to the policy
+        slot.exists = m_handle.jumpToElement(logicalIndex) == MStatus::kSuccess;
+        if (slot.exists) {
+            MDataHandle handle = m_handle.inputValue();
+            slot.value = getElementValue(m_valueGetter, handle, m_status);
+        }
+    }
+
+    MArrayDataHandle& m_handle;
+    T m_default;
+    Status m_status;
+    ValueGetter m_valueGetter;
+    CacheSlot m_cache[cacheSize];
+};
+
+/************************************
+Component list templates (MFnComponentListData into one flat index buffer)
+************************************/
+
+struct ComponentIndices {
+    std::vector<int> indices;  // Sorted with no duplicates
+    IndexBitset membership;    // Only filled when it's asked for
+    bool contains(unsigned int index) const { return membership.test(index); }
+};
+
+/*
+Decode every single-indexed component in a component list into ret.indices
+Pass a componentType (like MFn::kMeshVertComponent) to skip any other kind of component
+Reuse ret between computes, and its buffers won't get reallocated
+*/
+template <typename Status = MStatus*, typename = ErrorPolicyT<Status>>
+inline void decodeComponentList(
+    const MObject& componentList, ComponentIndices& ret, MFn::Type componentType = MFn::kInvalid,
+    bool buildMembership = false, Status status=nullptr
+) {
+    ret.indices.clear();
+    ret.membership.clear();
+
+    MStatus st;
+    MFnComponentListData fnList(componentList, statusArg<Status>(st));
+    if (!reportStatus(status, st, "Could not read the component list")) {
+        return;
+    }
+
+    MIntArray elements;
+    int maxIdx = -1;
+    unsigned int compCount = fnList.length();
+    for (unsigned int c = 0; c < compCount; ++c) {
+        MObject comp = fnList[c];
+        if (componentType != MFn::kInvalid && comp.apiType() != componentType) {
+            continue;
+        }
+        MFnSingleIndexedComponent fnComp(comp, statusArg<Status>(st));
+        if (!reportStatus(status, st, "Could not read a component as single indexed")) {
+            continue;
+        }
+
+        if (fnComp.isComplete()) {
+            int numElements = 0;
+            fnComp.getCompleteData(numElements);
+            std::size_t start = ret.indices.size();
+            ret.indices.resize(start + numElements);
+            for (int i = 0; i < numElements; ++i) {
+                ret.indices[start + i] = i;
+            }
+            maxIdx = std::max(maxIdx, numElements - 1);
+            continue;
+        }
+
+        fnComp.getElements(elements);
+        unsigned int len = elements.length();
+        if (len == 0) {
+            continue;
+        }
+        std::size_t start = ret.indices.size();
+        ret.indices.resize(start + len);
+        elements.get(ret.indices.data() + start);
+        maxIdx = std::max(maxIdx, *std::max_element(ret.indices.begin() + start, ret.indices.end()));
+    }
+
+    if (maxIdx < 0) {
+        return;
+    }
+
+    // Sort and de-duplicate. When the indices are dense enough, marking them in a bitset and
+    // reading it back in order is a lot cheaper than a sort
+    unsigned int bitCount = static_cast<unsigned int>(maxIdx) + 1;
+    if (!buildMembership && ret.indices.size() < bitCount / 64) {
+        std::sort(ret.indices.begin(), ret.indices.end());
+        ret.indices.erase(std::unique(ret.indices.begin(), ret.indices.end()), ret.indices.end());
+        return;
+    }
+
+    ret.membership.reset(bitCount);
+    for (int idx : ret.indices) {
+        ret.membership.set(static_cast<unsigned int>(idx));
+    }
+    ret.indices.clear();
+    ret.membership.forEachSetBit([&ret](unsigned int idx) {
+        ret.indices.push_back(static_cast<int>(idx));
+    });
+    if (!buildMembership) {
+        ret.membership.clear();
+    }
+}
+
+// A valueGetter for component list inputs
+struct ComponentListValueGetter {
+    MFn::Type componentType = MFn::kInvalid;
+    bool buildMembership = false;
+
+    inline ComponentIndices operator()(MDataHandle& handle, MStatus* status=nullptr) const {
+        ComponentIndices ret;
+        decodeComponentList(handle.data(), ret, componentType, buildMembership, status);
+        return ret;
+    }
+};
+
+template <typename Status = MStatus*, typename = ErrorPolicyT<Status>>
+inline void getComponentListHandleData(
+    MDataHandle& handle, ComponentIndices& ret, MFn::Type componentType = MFn::kInvalid,
+    bool buildMembership = false, Status status=nullptr
+) {
+    decodeComponentList(handle.data(), ret, componentType, buildMembership, status);
+}
+
+template <typename Status = MStatus*, typename = ErrorPolicyT<Status>>
+inline void getComponentListHandleData(
+    MDataBlock& dataBlock, MObject& attr, ComponentIndices& ret,
+    MFn::Type componentType = MFn::kInvalid, bool buildMembership = false, Status status=nullptr
+) {
+    MStatus st;
+    MDataHandle handle = dataBlock.inputValue(attr, statusArg<Status>(st));
+    if (!reportStatus(status, st, "Could not get the component list handle")) {
+        ret.indices.clear();
+        ret.membership.clear();
+        return;
+    }
+    decodeComponentList(handle.data(), ret, componentType, buildMembership, status);
+}
+
+/************************************
+Matrix palette templates (matrix[] and bindPreMatrix[] into one aligned buffer)
+************************************/
+
+template <typename T, std::size_t Alignment>
+struct AlignedAllocator {
+    using value_type = T;
+    template <typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() = default;
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) {}
+
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+    }
+    void deallocate(T* p, std::size_t) { ::operator delete(p, std::align_val_t(Alignment)); }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const { return true; }
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment>&) const { return false; }
+};
+
+template <typename T>
+using AlignedVector = std::vector<T, AlignedAllocator<T, 32>>;
+
+template <typename Scalar>
+inline void fillIdentityMatrices(Scalar* dst, std::size_t count) {
+    std::fill_n(dst, count * 16, Scalar(0));
+    for (std::size_t i = 0; i < count * 16; i += 16) {
+        dst[i] = dst[i + 5] = dst[i + 10] = dst[i + 15] = Scalar(1);
+    }
+}
+
+template <typename Scalar>
+inline void copyMatrix(const MMatrix& mat, Scalar* dst) {
+    const double* src = &mat.matrix[0][0];
+    for (int i = 0; i < 16; ++i) {
+        dst[i] = static_cast<Scalar>(src[i]);
+    }
+}
+
+/*
+Multiply `count` row-major 4x4 matrices pairwise: out[i] = lhs[i] * rhs[i]
+Same order as MMatrix::operator*, so a skinning palette is bindPre * matrix
+All three buffers must be 32 byte aligned, and out can't alias the inputs
+*/
+template <typename Scalar>
+inline void multiplyMatrixBatch(
+    const Scalar* lhs, const Scalar* rhs, Scalar* out, std::size_t count
+) {
+#if defined(__AVX__)
+    if constexpr (std::is_same_v<Scalar, double>) {
+        // One row of doubles is one __m256d
+        for (std::size_t i = 0; i < count; ++i, lhs += 16, rhs += 16, out += 16) {
+            __m256d r0 = _mm256_load_pd(rhs);
+            __m256d r1 = _mm256_load_pd(rhs + 4);
+            __m256d r2 = _mm256_load_pd(rhs + 8);
+            __m256d r3 = _mm256_load_pd(rhs + 12);
+            for (int row = 0; row < 16; row += 4) {
+                __m256d acc = _mm256_mul_pd(_mm256_broadcast_sd(lhs + row), r0);
+                acc = _mm256_add_pd(acc, _mm256_mul_pd(_mm256_broadcast_sd(lhs + row + 1), r1));
+                acc = _mm256_add_pd(acc, _mm256_mul_pd(_mm256_broadcast_sd(lhs + row + 2), r2));
+                acc = _mm256_add_pd(acc, _mm256_mul_pd(_mm256_broadcast_sd(lhs + row + 3), r3));
+                _mm256_store_pd(out + row, acc);
+            }
+        }
+        return;
+    }
+#endif
+#if defined(__SSE__) || defined(_M_X64)
+    if constexpr (std::is_same_v<Scalar, float>) {
+        // One row of floats is one __m128
+        for (std::size_t i = 0; i < count; ++i, lhs += 16, rhs += 16, out += 16) {
+            __m128 r0 = _mm_load_ps(rhs);
+            __m128 r1 = _mm_load_ps(rhs + 4);
+            __m128 r2 = _mm_load_ps(rhs + 8);
+            __m128 r3 = _mm_load_ps(rhs + 12);
+            for (int row = 0; row < 16; row += 4) {
+                __m128 acc = _mm_mul_ps(_mm_set1_ps(lhs[row]), r0);
+                acc = _mm_add_ps(acc, _mm_mul_ps(_mm_set1_ps(lhs[row + 1]), r1));
+                acc = _mm_add_ps(acc, _mm_mul_ps(_mm_set1_ps(lhs[row + 2]), r2));
+                acc = _mm_add_ps(acc, _mm_mul_ps(_mm_set1_ps(lhs[row + 3]), r3));
+                _mm_store_ps(out + row, acc);
+            }
+        }
+        return;
+    }
+#endif
+    // Written so the compiler can vectorize the inner column loop on its own
+    for (std::size_t i = 0; i < count; ++i, lhs += 16, rhs += 16, out += 16) {
+        for (int row = 0; row < 16; row += 4) {
+            for (int col = 0; col < 4; ++col) {
+                out[row + col] = lhs[row] * rhs[col] + lhs[row + 1] * rhs[4 + col] +
+                                 lhs[row + 2] * rhs[8 + col] + lhs[row + 3] * rhs[12 + col];
+            }
+        }
+    }
+}
+
+/*
+The matrices, bindPreMatrices and final palette for a skinning-like node, stored back to back in
+one 32 byte aligned buffer of 16-scalar row-major matrices.
+Keep one of these on the node, and the buffer gets reused between computes
+*/
+template <typename Scalar = double>
+class MatrixPalette {
+   public:
+    using MatrixType = std::conditional_t<std::is_same_v<Scalar, float>, MFloatMatrix, MMatrix>;
+
+    void resize(unsigned int size) {
+        m_size = size;
+        m_buffer.resize(std::size_t(size) * 48);
+    }
+    unsigned int size() const { return m_size; }
+
+    Scalar* matrices() { return m_buffer.data(); }
+    Scalar* bindPreMatrices() { return m_buffer.data() + std::size_t(m_size) * 16; }
+    Scalar* palette() { return m_buffer.data() + std::size_t(m_size) * 32; }
+    const Scalar* matrices() const { return m_buffer.data(); }
+    const Scalar* bindPreMatrices() const { return m_buffer.data() + std::size_t(m_size) * 16; }
+    const Scalar* palette() const { return m_buffer.data() + std::size_t(m_size) * 32; }
+
+    // The row-major 16 scalars of a single palette matrix
+    const Scalar* operator[](unsigned int index) const { return palette() + std::size_t(index) * 16; }
+
+    MatrixType paletteMatrix(unsigned int index) const {
+        return MatrixType(reinterpret_cast<const Scalar(*)[4]>((*this)[index]));
+    }
+
+    // Rebuild the palette from the current matrices and bindPreMatrices
+    void premultiply() { multiplyMatrixBatch(bindPreMatrices(), matrices(), palette(), m_size); }
+
+   private:
+    AlignedVector<Scalar> m_buffer;
+    unsigned int m_size = 0;
+};
+
+// Copy the matrices of an array handle into `count` consecutive slots
+// Runs of missing indices get filled with identity all at once
+template <typename Scalar, typename Status = MStatus*, typename = ErrorPolicyT<Status>>
+inline void getMatrixBlockHandleData(
+    MArrayDataHandle& arrayHandle, Scalar* dst, unsigned int count, Status status=nullptr
+) {
+    unsigned int prevIdx = 0;
+    for (auto [index, handle] : MArrayInputDataHandleRange(arrayHandle)) {
+        if (index >= count) {
+            break;
+        }
+        fillIdentityMatrices(dst + std::size_t(prevIdx) * 16, index - prevIdx);
+        MMatrix mat = getElementValue(DefaultHandleValueGetter<MMatrix>(), handle, status);
+        copyMatrix(mat, dst + std::size_t(index) * 16);
+        prevIdx = index + 1;
+    }
+    fillIdentityMatrices(dst + std::size_t(prevIdx) * 16, count - prevIdx);
+}
+
+template <typename Scalar, typename Status = MStatus*, typename = ErrorPolicyT<Status>>
+inline void getMatrixPaletteHandleData(
+    MArrayDataHandle& matrixHandle, MArrayDataHandle& bindPreHandle, MatrixPalette<Scalar>& ret,
+    unsigned int minSize = 0, Status status=nullptr
+) {
+    unsigned int size = std::max(
+        {getArrayLogicalSize(matrixHandle), getArrayLogicalSize(bindPreHandle), minSize}
+    );
+    ret.resize(size);
+    getMatrixBlockHandleData(matrixHandle, ret.matrices(), size, status);
+    getMatrixBlockHandleData(bindPreHandle, ret.bindPreMatrices(), size, status);
+    ret.premultiply();
+}
+
+template <typename Scalar, typename Status = MStatus*, typename = ErrorPolicyT<Status>>
+inline void getMatrixPaletteHandleData(
+    MDataBlock& dataBlock, MObject& matrixAttr, MObject& bindPreAttr, MatrixPalette<Scalar>& ret,
+    unsigned int minSize = 0, Status status=nullptr
+) {
+    MStatus st;
+    MArrayDataHandle matrixHandle = dataBlock.inputArrayValue(matrixAttr, statusArg<Status>(st));
+    if (!reportStatus(status, st, "Could not get the matrix array handle")) {
+        return;
+    }
+    MArrayDataHandle bindPreHandle = dataBlock.inputArrayValue(bindPreAttr, statusArg<Status>(st));
+    if (!reportStatus(status, st, "Could not get the bindPreMatrix array handle")) {
+        return;
+    }
+    getMatrixPaletteHandleData(matrixHandle, bindPreHandle, ret, minSize, status);
+}
+
+/************************************
+Interned strings (string inputs as stable integer ids)
+*************************************
+Keep a StringTable on your node, and string inputs come back as ids that stay the same across
+computes. Comparing names is then just comparing ids.
+
+Pass the ids from the last compute back in, and they get used as hints. A string that hasn't
+changed is checked against its old id with one compare, and never gets hashed or copied.
+
+    StringTable::Id wanted = m_strings.intern("translateX");
+    getInternedArrayHandleData(dataBlock, aNames, m_strings, m_nameIds);
+    for (StringTable::Id id : m_nameIds) {
+        if (id == wanted) { ... }
+    }
+************************************/
+
+class StringTable {
+   public:
+    using Id = unsigned int;
+    static constexpr Id invalidId = ~Id(0);
+
+    Id intern(std::string_view str, Id hint = invalidId) {
+        if (hint < m_strings.size() && m_strings[hint] == str) {
+            return hint;
+        }
+        auto it = m_lookup.find(str);
+        if (it != m_lookup.end()) {
+            return it->second;
+        }
+        Id id = static_cast<Id>(m_strings.size());
+        m_strings.emplace_back(str);
+        // Key on the stored copy. Deque elements don't move when it grows
+        m_lookup.emplace(m_strings.back(), id);
+        return id;
+    }
+    Id intern(const char* str, Id hint = invalidId) {
+        return intern(std::string_view(str), hint);
+    }
+    Id intern(const MString& str, Id hint = invalidId) { return intern(str.asChar(), hint); }
+
+    // Like intern, but never adds anything. Returns invalidId if the string isn't in the table
+    Id find(std::string_view str) const {
+        auto it = m_lookup.find(str);
+        return it == m_lookup.end() ? invalidId : it->second;
+    }
+
+    const std::string& str(Id id) const { return m_strings[id]; }
+    MString mstring(Id id) const { return MString(m_strings[id].c_str()); }
+    std::size_t size() const { return m_strings.size(); }
+
+    void clear() {
+        m_lookup.clear();
+        m_strings.clear();
+    }
+
+    // The table only ever grows, so strings that came from editable inputs pile up over the life
+    // of the node. Compact it now and then, passing every id (or list of ids) you're keeping.
+    // Only the strings they use are kept, and the ids get renumbered in place.
+    // Any id that isn't passed in is invalid afterwards
+    //
+    //     if (m_strings.size() > 4 * m_nameIds.size() + 64) {
+    //         m_strings.compact(wanted, m_nameIds);
+    //     }
+    template <typename... IdLists>
+    void compact(IdLists&... idLists) {
+        std::vector<Id> remap(m_strings.size(), invalidId);
+        (markIds(idLists, remap), ...);
+
+        std::deque<std::string> strings;
+        for (Id id = 0; id < remap.size(); ++id) {
+            if (remap[id] != invalidId) {
+                remap[id] = static_cast<Id>(strings.size());
+                strings.push_back(std::move(m_strings[id]));
+            }
+        }
+        m_strings = std::move(strings);
+        m_lookup.clear();
+        for (Id id = 0; id < m_strings.size(); ++id) {
+            m_lookup.emplace(m_strings[id], id);
+        }
+        (remapIds(idLists, remap), ...);
+    }
+
+   private:
+    // Flag the ids in use. The real new ids get filled in by compact
+    static void markIds(Id& id, std::vector<Id>& remap) {
+        if (id < remap.size()) {
+            remap[id] = 0;
+        }
+    }
+    template <typename IDXS>
+    static void markIds(IDXS& ids, std::vector<Id>& remap) {
+        for (Id& id : ids) {
+            markIds(id, remap);
+        }
+    }
+
+    static void remapIds(Id& id, const std::vector<Id>& remap) {
+        id = id < remap.size() ? remap[id] : invalidId;
+    }
+    template <typename IDXS>
+    static void remapIds(IDXS& ids, const std::vector<Id>& remap) {
+        for (Id& id : ids) {
+            remapIds(id, remap);
+        }
+    }
+
+    std::deque<std::string> m_strings;
+    std::unordered_map<std::string_view, Id> m_lookup;
+};
+
+// A valueGetter that interns string inputs. This one doesn't get hints, so it always hashes
+struct InternedStringValueGetter {
+    StringTable& table;
+    inline StringTable::Id operator()(MDataHandle& handle, MStatus* status=nullptr) const {
+        return table.intern(handle.asString());
+    }
+};
+
+// Intern a single string input. `id` is both the hint and the result
+inline void getInternedHandleData(MDataHandle& handle, StringTable& table, StringTable::Id& id) {
+    id = table.intern(handle.asString(), id);
+}
+
+// Intern a string array plug into `ids` like getFullArrayHandleData does, with missing indices
+// filled with the id of the empty string. Reading strings can't fail, so there's no status here
+inline void getInternedArrayHandleData(
+    MArrayDataHandle& arrayHandle, StringTable& table, std::vector<StringTable::Id>& ids,
+    unsigned int minSize = 0
+) {
+    std::size_t hintCount = ids.size();
+    unsigned int size = std::max(getArrayLogicalSize(arrayHandle), minSize);
+    ids.resize(size);
+    StringTable::Id emptyId = table.intern(std::string_view());
+
+    auto valuePusher = [&](unsigned int index, MDataHandle& handle) {
+        StringTable::Id hint = index < hintCount ? ids[index] : StringTable::invalidId;
+        ids[index] = table.intern(handle.asString(), hint);
+    };
+    auto defaultPusher = [&](unsigned int index) { ids[index] = emptyId; };
+    getFullArrayMultiHandleData(arrayHandle, size, defaultPusher, valuePusher);
+}
+
+template <typename Status = MStatus*, typename = ErrorPolicyT<Status>>
+inline void getInternedArrayHandleData(
+    MDataBlock& dataBlock, MObject& attr, StringTable& table, std::vector<StringTable::Id>& ids,
+    unsigned int minSize = 0, Status status=nullptr
+) {
+    MStatus st;
+    MArrayDataHandle arrayHandle = dataBlock.inputArrayValue(attr, statusArg<Status>(st));
+    if (!reportStatus(status, st, "Could not get the input array handle")) {
+        return;
+    }
+    getInternedArrayHandleData(arrayHandle, table, ids, minSize);
+}
+
+// Intern an MStringArray typed input. Ids are hinted by position
+template <typename Status = MStatus*, typename = ErrorPolicyT<Status>>
+inline void getInternedStringArrayHandleData(
+    MDataHandle& handle, StringTable& table, std::vector<StringTable::Id>& ids,
+    Status status=nullptr
+) {
+    MStatus st;
+    MStringArray strs = hg_impl<MStringArray, MFnStringArrayData>(handle, statusArg<Status>(st));
+    if (!reportStatus(status, st, "Could not read the string array")) {
+        ids.clear();
+        return;
+    }
+    std::size_t hintCount = ids.size();
+    unsigned int count = strs.length();
+    ids.resize(count);
+    for (unsigned int i = 0; i < count; ++i) {
+        ids[i] = table.intern(strs[i], i < hintCount ? ids[i] : StringTable::invalidId);
+    }
+}
+
+template <typename Status = MStatus*, typename = ErrorPolicyT<Status>>
+inline void getInternedStringArrayHandleData(
+    MDataBlock& dataBlock, MObject& attr, StringTable& table, std::vector<StringTable::Id>& ids,
+    Status status=nullptr
+) {
+    MStatus st;
+    MDataHandle handle = dataBlock.inputValue(attr, statusArg<Status>(st));
+    if (!reportStatus(status, st, "Could not get the string array handle")) {
+        ids.clear();
+        return;
+    }
+    getInternedStringArrayHandleData(handle, table, ids, status);
+}
+
+/************************************
+Frame cache (LRU cache of output array data keyed on time)
+*************************************
+Keep one of these on your node. Before doing any work, try to restore the frame. On a miss,
+compute and write your outputs through the cache so they get stored for next time.
+The inputKey is whatever hash of the other inputs tells you two frames are actually the same.
+Frames get evicted oldest-used first once the cache is over its byte budget.
+
+    MTime time = dataBlock.inputValue(aTime).asTime();
+    std::uint64_t key = hashCombine(0, envelope);
+    if (m_frameCache.restore(dataBlock, time, key)) {
+        return MS::kSuccess;
+    }
+    ... compute ...
+    setCachedOutputArrayData(m_frameCache, dataBlock, time, key, aOutput, 0, {}, outValues);
+
+This is NOT THREADSAFE!
+************************************/
+
+// boost::hash_combine style mixing for building an inputKey
+template <typename T>
+inline std::uint64_t hashCombine(std::uint64_t seed, const T& value) {
+    std::uint64_t h = std::hash<T>()(value);
+    return seed ^ (h + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2));
+}
+
+// FNV-1a style hash over a raw buffer, for hashing whole input arrays
+// This mixes in a word at a time, so big arrays hash about 8x faster than byte-wise FNV
+inline std::uint64_t hashBytes(const void* data, std::size_t size, std::uint64_t seed = 0) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    std::uint64_t h = 0xcbf29ce484222325ULL ^ seed;
+    std::size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        std::uint64_t word;
+        std::memcpy(&word, bytes + i, 8);
+        h = (h ^ word) * 0x100000001b3ULL;
+        h ^= h >> 32;
+    }
+    for (; i < size; ++i) {
+        h = (h ^ bytes[i]) * 0x100000001b3ULL;
+    }
+    return h;
+}
+
+class FrameCache {
+   public:
+    explicit FrameCache(std::size_t byteBudget = 256 * 1024 * 1024) : m_budget(byteBudget) {}
+
+    std::size_t memoryUsage() const { return m_bytes; }
+    std::size_t budget() const { return m_budget; }
+    std::size_t frameCount() const { return m_frames.size(); }
+
+    void setBudget(std::size_t byteBudget) {
+        m_budget = byteBudget;
+        evict();
+    }
+
+    void clear() {
+        m_frames.clear();
+        m_lookup.clear();
+        m_bytes = 0;
+    }
+
+    bool contains(const MTime& time, std::uint64_t inputKey) const {
+        return m_lookup.count(makeKey(time, inputKey)) > 0;
+    }
+
+    // Store a copy of an output array value for this frame
+    // Storing to the same plug twice in one frame replaces the first value
+    template <typename T>
+    void store(
+        const MTime& time, std::uint64_t inputKey, MObject& parAttr, unsigned int index,
+        const std::vector<MObject>& children, const T& value
+    ) {
+        Frame& frame = touch(makeKey(time, inputKey));
+        auto output = std::make_unique<CachedOutput<T>>(parAttr, index, children, value);
+        m_bytes += output->bytes;
+        frame.bytes += output->bytes;
+
+        for (auto& prev : frame.outputs) {
+            if (prev->index == index && prev->parAttr == parAttr && prev->children == children) {
+                m_bytes -= prev->bytes;
+                frame.bytes -= prev->bytes;
+                prev = std::move(output);
+                evict();
+                return;
+            }
+        }
+        frame.outputs.push_back(std::move(output));
+        evict();
+    }
+
+    // Write every output stored for this frame back to the data block
+    // Returns false on a cache miss, or if any of the writes failed
+    template <typename Status = MStatus*, typename = ErrorPolicyT<Status>>
+    bool restore(
+        MDataBlock& block, const MTime& time, std::uint64_t inputKey, Status status=nullptr
+    ) {
+        auto it = m_lookup.find(makeKey(time, inputKey));
+        if (it == m_lookup.end()) {
+            return false;
+        }
+        // Move to the front so it's the last thing evicted
+        m_frames.splice(m_frames.begin(), m_frames, it->second);
+        for (auto& output : it->second->outputs) {
+            MStatus st = output->write(block);
+            if (!reportStatus(status, st, "Could not restore a cached output")) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+   private:
+    struct Key {
+        double ticks;
+        std::uint64_t inputKey;
+        bool operator==(const Key& other) const {
+            return ticks == other.ticks && inputKey == other.inputKey;
+        }
+    };
+
+    struct KeyHash {
+        std::size_t operator()(const Key& key) const {
+            return static_cast<std::size_t>(hashCombine(key.inputKey, key.ticks));
+        }
+    };
+
+    struct CachedOutputBase {
+        CachedOutputBase(MObject& inAttr, unsigned int inIndex, const std::vector<MObject>& inChildren)
+            : parAttr(inAttr), index(inIndex), children(inChildren) {}
+        virtual ~CachedOutputBase() = default;
+        virtual MStatus write(MDataBlock& block) = 0;
+
+        MObject parAttr;
+        unsigned int index;
+        std::vector<MObject> children;
+        std::size_t bytes = 0;
+    };
+
+    template <typename T>
+    struct CachedOutput : CachedOutputBase {
+        CachedOutput(
+            MObject& inAttr, unsigned int inIndex, const std::vector<MObject>& inChildren,
+            const T& inValue
+        )
+            : CachedOutputBase(inAttr, inIndex, inChildren), value(inValue) {
+            bytes = sizeof(*this) + std::size_t(getlen(value)) * sizeof(ETypeT<T>);
+        }
+
+        MStatus write(MDataBlock& block) override {
+            MStatus st;
+            setOutputArrayData(block, parAttr, index, children, value, &st);
+            return st;
+        }
+
+        T value;
+    };
+
+    struct Frame {
+        Key key;
+        std::vector<std::unique_ptr<CachedOutputBase>> outputs;
+        std::size_t bytes = 0;
+    };
+
+    static Key makeKey(const MTime& time, std::uint64_t inputKey) {
+        // Key on a fixed unit so changing the scene fps doesn't alias frames
+        return {time.as(MTime::k6000FPS), inputKey};
+    }
+
+    // Find or create the frame for a key, and move it to the front
+    Frame& touch(const Key& key) {
+        auto it = m_lookup.find(key);
+        if (it != m_lookup.end()) {
+            m_frames.splice(m_frames.begin(), m_frames, it->second);
+            return m_frames.front();
+        }
+        m_frames.emplace_front();
+        m_frames.front().key = key;
+        m_lookup[key] = m_frames.begin();
+        return m_frames.front();
+    }
+
+    // Drop the least recently used frames until we're under budget
+    // The most recent frame always stays, even if it's over budget on its own
+    void evict() {
+        while (m_bytes > m_budget && m_frames.size() > 1) {
+            Frame& last = m_frames.back();
+            m_bytes -= last.bytes;
+            m_lookup.erase(last.key);
+            m_frames.pop_back();
+        }
+    }
+
+    std::list<Frame> m_frames;  // Most recently used at the front
+    std::unordered_map<Key, std::list<Frame>::iterator, KeyHash> m_lookup;
+    std::size_t m_bytes = 0;
+    std::size_t m_budget;
+};
+
+// setOutputArrayData, and also store the value in the frame cache if the write worked
+// With errors turned off (IgnoreErrors in release) failures can't be seen, so it always stores
+template <typename T, typename Status = MStatus*, typename = ErrorPolicyT<Status>>
+inline MDataHandle setCachedOutputArrayData(
+    FrameCache& cache, MDataBlock& block, const MTime& time, std::uint64_t inputKey,
+    MObject& parAttr, unsigned int index, const std::vector<MObject>& children, T& value,
+    Status status=nullptr
+) {
+    if constexpr (ErrorsEnabledV<Status>) {
+        // Catch the failure here so a write that didn't happen never gets cached
+        FirstError first;
+        MDataHandle handle = setOutputArrayData(block, parAttr, index, children, value, &first);
+        if (!reportStatus(status, first.status, first.message)) {
+            return handle;
+        }
+        cache.store(time, inputKey, parAttr, index, children, value);
+        return handle;
+    } else {
+        MDataHandle handle = setOutputArrayData(block, parAttr, index, children, value, status);
+        cache.store(time, inputKey, parAttr, index, children, value);
+        return handle;
+    }
+}
+
+/************************************
+Output mesh builder (only rebuild output meshes when the topology changes)
+*************************************
+Keep one of these on your node for each output mesh. It remembers a hash of the last topology
+it built. When the topology hasn't changed, the points get set in place on the mesh data that's
+already on the output, and only a topology change does a full MFnMesh::create.
+
+    m_outMesh.setOutputMesh(dataBlock, aOutMesh, points, faceCounts, faceConnects);
+************************************/
+
+// The const MIntArray operator[] returns by value, so the ints get copied out with get() into
+// a scratch buffer first. Reuse the scratch buffer between calls
+inline std::uint64_t hashTopology(
+    const MIntArray& counts, const MIntArray& connects, std::vector<int>& scratch
+) {
+    scratch.resize(std::max(counts.length(), connects.length()));
+    counts.get(scratch.data());
+    std::uint64_t h = hashBytes(scratch.data(), sizeof(int) * counts.length());
+    connects.get(scratch.data());
+    return hashBytes(scratch.data(), sizeof(int) * connects.length(), h);
+}
+
+class OutputMeshBuilder {
+   public:
+    // Returns true if the mesh was set, either in place or by rebuilding it
+    // points isn't const because MFnMesh::setPoints takes a non-const array. It isn't changed
+    template <typename PointArray, typename Status = MStatus*, typename = ErrorPolicyT<Status>>
+    bool setOutputMesh(
+        MDataHandle& outHandle, PointArray& points, const MIntArray& counts,
+        const MIntArray& connects, Status status=nullptr
+    ) {
+        MStatus st;
+        std::uint64_t topologyHash = hashTopology(counts, connects, m_scratch);
+        // Check the lengths too, so a hash collision alone can't put points on the wrong topology
+        if (m_hasTopology && topologyHash == m_topologyHash && counts.length() == m_numCounts &&
+            connects.length() == m_numConnects) {
+            MObject existing = outHandle.data();
+            if (!existing.isNull()) {
+                MFnMesh fnMesh(existing, &st);
+                if (st && static_cast<unsigned int>(fnMesh.numVertices()) == points.length()) {
+                    st = fnMesh.setPoints(points);
+                    if (!reportStatus(status, st, "Could not set the output mesh points")) {
+                        return false;
+                    }
+                    outHandle.setClean();
+                    m_rebuilt = false;
+                    return true;
+                }
+            }
+        }
+
+        MFnMeshData fnData;
+        MObject dataObj = fnData.create(statusArg<Status>(st));
+        if (!reportStatus(status, st, "Could not create the output mesh data")) {
+            return false;
+        }
+        MFnMesh fnMesh;
+        fnMesh.create(
+            static_cast<int>(points.length()), static_cast<int>(counts.length()), points, counts,
+            connects, dataObj, statusArg<Status>(st)
+        );
+        if (!reportStatus(status, st, "Could not create the output mesh")) {
+            return false;
+        }
+        outHandle.set(dataObj);
+        outHandle.setClean();
+
+        m_topologyHash = topologyHash;
+        m_numCounts = counts.length();
+        m_numConnects = connects.length();
+        m_hasTopology = true;
+        m_rebuilt = true;
+        return true;
+    }
+
+    template <typename PointArray, typename Status = MStatus*, typename = ErrorPolicyT<Status>>
+    bool setOutputMesh(
+        MDataBlock& block, MObject& attr, PointArray& points, const MIntArray& counts,
+        const MIntArray& connects, Status status=nullptr
+    ) {
+        MStatus st;
+        MDataHandle outHandle = block.outputValue(attr, statusArg<Status>(st));
+        if (!reportStatus(status, st, "Could not get the output mesh handle")) {
+            return false;
+        }
+        return setOutputMesh(outHandle, points, counts, connects, status);
+    }
+
+    // Whether the last setOutputMesh had to do a full create
+    bool lastWasRebuild() const { return m_rebuilt; }
+
+    // Force the next setOutputMesh to rebuild
+    void reset() { m_hasTopology = false; }
+
+   private:
+    std::uint64_t m_topologyHash = 0;
+    unsigned int m_numCounts = 0;
+    unsigned int m_numConnects = 0;
+    bool m_hasTopology = false;
+    bool m_rebuilt = false;
+    std::vector<int> m_scratch;
+};
+
+/************************************
+Ramp lookup tables (compile a ramp compound array into a uniformly sampled table)
+*************************************
+Reads a ramp style compound array (position/value/interp children) in one pass and resamples it
+into a table, so evaluating the ramp is a table lookup instead of a search over the ramp points.
+Keep the table on your node so its buffers get reused between computes.
+
+    getRampLookupTable(dataBlock, aFalloff, aFalloffPosition, aFalloffValue, aFalloffInterp, m_falloff, 512);
+    m_falloff.sampleBatch(distances.data(), weights.data(), distances.size());
+************************************/
+
+struct RampPoint {
+    float position;
+    float value;
+    short interp;  // Same as the maya ramp enum. 0: None, 1: Linear, 2: Smooth, 3: Spline
+};
+
+class RampLookupTable {
+   public:
+    // Starts out as a flat zero table, so sampling before build() is still safe
+    RampLookupTable() : m_table(3, 0.0f) {}
+
+    // Sort the points and resample them into `resolution` evenly spaced samples over [0, 1]
+    void build(std::vector<RampPoint>& points, unsigned int resolution) {
+        resolution = std::max(resolution, 2u);
+        m_resolution = resolution;
+        // One extra sample on the end so lookups at 1.0 don't need a bounds check
+        m_table.assign(resolution + 1, 0.0f);
+        if (points.empty()) {
+            return;
+        }
+        std::sort(points.begin(), points.end(), [](const RampPoint& a, const RampPoint& b) {
+            return a.position < b.position;
+        });
+
+        std::size_t seg = 0;
+        std::size_t last = points.size() - 1;
+        for (unsigned int i = 0; i < resolution; ++i) {
+            float x = static_cast<float>(i) / static_cast<float>(resolution - 1);
+            // The samples increase, so the segment only ever walks forward
+            while (seg < last && points[seg + 1].position <= x) {
+                ++seg;
+            }
+            m_table[i] = evalSegment(points, seg, x);
+        }
+        m_table[resolution] = m_table[resolution - 1];
+    }
+
+    unsigned int resolution() const { return m_resolution; }
+    const float* table() const { return m_table.data(); }
+
+    float sample(float param) const {
+        float f = clampParam(param) * static_cast<float>(m_resolution - 1);
+        unsigned int i = static_cast<unsigned int>(f);
+        float t = f - static_cast<float>(i);
+        return m_table[i] + t * (m_table[i + 1] - m_table[i]);
+    }
+
+    void sampleBatch(const float* params, float* out, std::size_t count) const {
+        const float* table = m_table.data();
+        const float scale = static_cast<float>(m_resolution - 1);
+        std::size_t i = 0;
+#if defined(__AVX2__)
+        const __m256 zero = _mm256_setzero_ps();
+        const __m256 one = _mm256_set1_ps(1.0f);
+        const __m256 vscale = _mm256_set1_ps(scale);
+        for (; i + 8 <= count; i += 8) {
+            __m256 p = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(params + i), zero), one);
+            __m256 f = _mm256_mul_ps(p, vscale);
+            __m256 fl = _mm256_floor_ps(f);
+            __m256i idx = _mm256_cvttps_epi32(fl);
+            __m256 t = _mm256_sub_ps(f, fl);
+            __m256 a = _mm256_i32gather_ps(table, idx, 4);
+            __m256 b = _mm256_i32gather_ps(table + 1, idx, 4);
+            _mm256_storeu_ps(out + i, _mm256_add_ps(a, _mm256_mul_ps(t, _mm256_sub_ps(b, a))));
+        }
+#endif
+        for (; i < count; ++i) {
+            float f = clampParam(params[i]) * scale;
+            unsigned int idx = static_cast<unsigned int>(f);
+            float t = f - static_cast<float>(idx);
+            out[i] = table[idx] + t * (table[idx + 1] - table[idx]);
+        }
+    }
+
+    // Kept around so the point buffer gets reused between computes
+    std::vector<RampPoint> points;
+
+   private:
+    // Clamp to [0, 1], with NaN going to 0 the same way the AVX2 max does
+    static float clampParam(float param) { return param > 0.0f ? std::min(param, 1.0f) : 0.0f; }
+
+    static float evalSegment(const std::vector<RampPoint>& points, std::size_t seg, float x) {
+        const RampPoint& p0 = points[seg];
+        if (x <= p0.position || seg + 1 >= points.size()) {
+            // Before the first point, or past the last one
+            return p0.value;
+        }
+        const RampPoint& p1 = points[seg + 1];
+        float span = p1.position - p0.position;
+        float t = span > 0.0f ? (x - p0.position) / span : 1.0f;
+        switch (p0.interp) {
+            case 0:
+                return p0.value;
+            case 2:
+                t = t * t * (3.0f - 2.0f * t);
+                return p0.value + t * (p1.value - p0.value);
+            case 3: {
+                // Catmull-Rom, using the end points again past either end
+                float pm = seg > 0 ? points[seg - 1].value : p0.value;
+                float p2 = seg + 2 < points.size() ? points[seg + 2].value : p1.value;
+                float t2 = t * t;
+                float t3 = t2 * t;
+                return 0.5f * ((2.0f * p0.value) + (p1.value - pm) * t +
+                               (2.0f * pm - 5.0f * p0.value + 4.0f * p1.value - p2) * t2 +
+                               (3.0f * p0.value - pm - 3.0f * p1.value + p2) * t3);
+            }
+            default:
+                return p0.value + t * (p1.value - p0.value);
+        }
+    }
+
+    AlignedVector<float> m_table;
+    unsigned int m_resolution = 2;
+};
+
+// Reading the children can't fail, so there's no status here
+// interpAttr is optional. Pass MObject::kNullObj and every point is linear
+inline void getRampLookupTable(
+    MArrayDataHandle& arrayHandle, const MObject& positionAttr, const MObject& valueAttr,
+    const MObject& interpAttr,
+    RampLookupTable& ret, unsigned int resolution = 256
+) {
+    ret.points.clear();
+    bool hasInterp = !interpAttr.isNull();
+    for (auto [index, handle] : MArrayInputDataHandleRange(arrayHandle)) {
+        RampPoint point;
+        point.position = handle.child(positionAttr).asFloat();
+        point.value = handle.child(valueAttr).asFloat();
+        point.interp = hasInterp ? handle.child(interpAttr).asShort() : short(1);
+        ret.points.push_back(point);
+    }
+    ret.build(ret.points, resolution);
+}
+
+template <typename Status = MStatus*, typename = ErrorPolicyT<Status>>
+inline void getRampLookupTable(
+    MDataBlock& dataBlock, MObject& attr, const MObject& positionAttr, const MObject& valueAttr,
+    const MObject& interpAttr, RampLookupTable& ret, unsigned int resolution = 256, Status status=nullptr
+) {
+    MStatus st;
+    MArrayDataHandle arrayHandle = dataBlock.inputArrayValue(attr, statusArg<Status>(st));
+    if (!reportStatus(status, st, "Could not get the ramp array handle")) {
+        return;
+    }
+    getRampLookupTable(arrayHandle, positionAttr, valueAttr, interpAttr, ret, resolution);
+}
+
+/************************************
+MPlug getter templates (the same getters, for outside of compute)
+*************************************
+For draw overrides, commands and tools that don't have a data block.
+These pull the whole array plug into one data handle with a single asMDataHandle call, and then
+hand it to the MArrayDataHandle getters. So the children, the valueGetters and the containers
+all work exactly the same way, and there's only one destructHandle at the end.
+************************************/
+
+// Call func(arrayHandle) with an MArrayDataHandle over the whole array plug
+template <typename Func, typename Status = MStatus*, typename = ErrorPolicyT<Status>>
+inline void withPlugArrayHandle(MPlug& arrayPlug, Func func, Status status=nullptr) {
+    MStatus st;
+    MDataHandle handle = arrayPlug.asMDataHandle(statusArg<Status>(st));
+    if (!reportStatus(status, st, "Could not get the data handle for the array plug")) {
+        return;
+    }
+    // Make sure the handle gets destructed, even if the policy throws
+    struct HandleGuard {
+        MPlug& plug;
+        MDataHandle& handle;
+        ~HandleGuard() { plug.destructHandle(handle); }
+    } guard{arrayPlug, handle};
+
+    MArrayDataHandle arrayHandle(handle, statusArg<Status>(st));
+    if (!reportStatus(status, st, "Could not get the array handle for the array plug")) {
+        return;
+    }
+    func(arrayHandle);
+}
+
+/////
+// Full
+/////
+template <
+    typename T, typename ValueGetter = DefaultHandleValueGetter<ETypeT<T>>,
+    typename Status = MStatus*, typename = ErrorPolicyT<Status>>
+inline void getFullArrayHandleData(
+    MPlug& arrayPlug, const std::vector<MObject>& children, T& ret, unsigned int minSize,
+    Status status=nullptr, ValueGetter valueGetter = ValueGetter()
+) {
+    withPlugArrayHandle(arrayPlug, [&](MArrayDataHandle& arrayHandle) {
+        getFullArrayHandleData(arrayHandle, children, ret, minSize, status, valueGetter);
+    }, status);
+}
+
+template <
+    typename T, typename ValueGetter = DefaultHandleValueGetter<ETypeT<T>>,
+    typename Status = MStatus*, typename = ErrorPolicyT<Status>>
+inline void getFullArrayHandleData(
+    MPlug& arrayPlug, T& ret, unsigned int minSize, Status status=nullptr,
+    ValueGetter valueGetter = ValueGetter()
+) {
+    withPlugArrayHandle(arrayPlug, [&](MArrayDataHandle& arrayHandle) {
+        getFullArrayHandleData(arrayHandle, ret, minSize, status, valueGetter);
+    }, status);
+}
+
+template <
+    typename T, typename ValueGetter = DefaultHandleValueGetter<ETypeT<T>>,
+    typename Status = MStatus*, typename = ErrorPolicyT<Status>>
+inline void getFullArrayHandleData(
+    MPlug& arrayPlug, const std::vector<MObject>& children, T& ret, Status status=nullptr,
+    ValueGetter valueGetter = ValueGetter()
+) {
+    getFullArrayHandleData(arrayPlug, children, ret, 0, status, valueGetter);
+}
+
+template <
+    typename T, typename ValueGetter = DefaultHandleValueGetter<ETypeT<T>>,
+    typename Status = MStatus*, typename = ErrorPolicyT<Status>>
+inline void getFullArrayHandleData(
+    MPlug& arrayPlug, T& ret, Status status=nullptr, ValueGetter valueGetter = ValueGetter()
+) {
+    getFullArrayHandleData(arrayPlug, ret, 0, status, valueGetter);
+}
+
+/////
+// Compact
+/////
+template <
+    typename T, typename ValueGetter = DefaultHandleValueGetter<ETypeT<T>>,
+    typename Status = MStatus*, typename = ErrorPolicyT<Status>>
+inline void getCompactArrayHandleData(
+    MPlug& arrayPlug, const std::vector<MObject>& children, T& ret, Status status=nullptr,
+    ValueGetter valueGetter = ValueGetter()
+) {
+    withPlugArrayHandle(arrayPlug, [&](MArrayDataHandle& arrayHandle) {
+        getCompactArrayHandleData(arrayHandle, children, ret, status, valueGetter);
+    }, status);
+}
+
+template <
+    typename T, typename ValueGetter = DefaultHandleValueGetter<ETypeT<T>>,
+    typename Status = MStatus*, typename = ErrorPolicyT<Status>>
+inline void getCompactArrayHandleData(
+    MPlug& arrayPlug, T& ret, Status status=nullptr, ValueGetter valueGetter = ValueGetter()
+) {
+    withPlugArrayHandle(arrayPlug, [&](MArrayDataHandle& arrayHandle) {
+        getCompactArrayHandleData(arrayHandle, ret, status, valueGetter);
+    }, status);
+}
+
+template <
+    typename T, typename IDXS, typename ValueGetter = DefaultHandleValueGetter<ETypeT<T>>,
+    typename Status = MStatus*, typename = ErrorPolicyT<Status>>
+inline void getCompactIndexArrayHandleData(
+    MPlug& arrayPlug, const std::vector<MObject>& children, T& ret, IDXS& idxs,
+    Status status=nullptr, ValueGetter valueGetter = ValueGetter()
+) {
+    withPlugArrayHandle(arrayPlug, [&](MArrayDataHandle& arrayHandle) {
+        getCompactIndexArrayHandleData(arrayHandle, children, ret, idxs, status, valueGetter);
+    }, status);
+}
+
+template <
+    typename T, typename IDXS, typename ValueGetter = DefaultHandleValueGetter<ETypeT<T>>,
+    typename Status = MStatus*, typename = ErrorPolicyT<Status>>
+inline void getCompactIndexArrayHandleData(
+    MPlug& arrayPlug, T& ret, IDXS& idxs, Status status=nullptr,
+    ValueGetter valueGetter = ValueGetter()
+) {
+    withPlugArrayHandle(arrayPlug, [&](MArrayDataHandle& arrayHandle) {
+        getCompactIndexArrayHandleData(arrayHandle, ret, idxs, status, valueGetter);
+    }, status);
+}
+
+/////
+// Sparse
+/////
+template <
+    typename Map, typename T = typename Map::mapped_type, typename ValueGetter = DefaultHandleValueGetter<T>,
+    typename Status = MStatus*, typename = ErrorPolicyT<Status>>
+inline void getSparseArrayHandleData(
+    MPlug& arrayPlug, const std::vector<MObject>& children, Map& ret, Status status=nullptr,
+    ValueGetter valueGetter = ValueGetter()
+) {
+    withPlugArrayHandle(arrayPlug, [&](MArrayDataHandle& arrayHandle) {
+        getSparseArrayHandleData(arrayHandle, children, ret, status, valueGetter);
+    }, status);
+}
+
+template <
+    typename Map, typename T = typename Map::mapped_type, typename ValueGetter = DefaultHandleValueGetter<T>,
+    typename Status = MStatus*, typename = ErrorPolicyT<Status>>
+inline void getSparseArrayHandleData(
+    MPlug& arrayPlug, Map& ret, Status status=nullptr, ValueGetter valueGetter = ValueGetter()
+) {
+    withPlugArrayHandle(arrayPlug, [&](MArrayDataHandle& arrayHandle) {
+        getSparseArrayHandleData(arrayHandle, ret, status, valueGetter);
+    }, status);
+}
+
 /************************************
 Reminder templates
 *************************************